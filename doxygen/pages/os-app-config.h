@@ -359,6 +359,37 @@
  */
 #define OS_INTEGER_RTOS_IDLE_STACK_SIZE_BYTES
 
+/**
+ * @brief Define the **reaper** thread stack size.
+ *
+ * @details
+ * Used only when `OS_INCLUDE_RTOS_THREAD_REAPER` is defined.
+ *
+ * @note Ignored for synthetic platforms.
+ */
+#define OS_INTEGER_RTOS_REAPER_STACK_SIZE_BYTES
+
+/**
+ * @brief Define the **timer daemon** thread stack size.
+ *
+ * @details
+ * Used only when `OS_INCLUDE_RTOS_TIMER_DAEMON` is defined.
+ *
+ * @note Ignored for synthetic platforms.
+ */
+#define OS_INTEGER_RTOS_TIMER_DAEMON_STACK_SIZE_BYTES
+
+/**
+ * @brief Define the **timer daemon** thread priority.
+ *
+ * @details
+ * Used only when `OS_INCLUDE_RTOS_TIMER_DAEMON` is defined.
+ *
+ * @par Default
+ * `thread::priority::high`.
+ */
+#define OS_INTEGER_RTOS_TIMER_DAEMON_PRIORITY
+
 /**
  * @brief Include statistics to count thread CPU cycles.
  *
@@ -406,6 +437,75 @@
  */
 #define OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES
 
+/**
+ * @brief Include statistics to measure the thread wakeup latency.
+ *
+ * @details
+ * Add support to measure, for each thread, the time from the moment it
+ * is woken up and linked to the ready list, until it is selected
+ * to run, using the high resolution clock.
+ *
+ * The measurements are accumulated in a histogram with 16 buckets on
+ * a fixed logarithmic scale, and the maximum latency is also
+ * preserved. No dynamic memory is used.
+ *
+ * The RAM overhead of enabling this option is about 150 bytes for
+ * each thread.
+ *
+ * The time overhead is moderate, reading the high resolution clock
+ * each time a thread is woken up and when it is scheduled to run.
+ *
+ * @see os::rtos::thread::statistics::wakeup_latency()
+ * @see os::rtos::thread::statistics::wakeup_latency_max()
+ *
+ * @par Default
+ * Disable. Do not include wakeup latency statistics.
+ */
+#define OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY
+
+/**
+ * @brief Include statistics to compute the thread CPU load.
+ *
+ * @details
+ * Add support to compute, for each thread, the share of the CPU
+ * time used in recent time windows, for example to implement
+ * a watchdog that sheds load based on the actual CPU utilisation.
+ *
+ * The time is split in windows of
+ * @ref OS_INTEGER_RTOS_STATISTICS_CPU_LOAD_WINDOW_TICKS, and the
+ * load of the last 60 windows is kept for each thread, including
+ * the idle thread. With the default one second windows,
+ * the usual 1s/10s/60s averages are available.
+ *
+ * The RAM overhead of enabling this option is about 140 bytes for
+ * each thread, and about 500 bytes for the scheduler.
+ *
+ * The time overhead is low; windows are closed lazily for
+ * each thread, and the SysTick handler does a constant amount
+ * of work, regardless the number of threads.
+ *
+ * Requires @ref OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES.
+ *
+ * @see os::rtos::thread::statistics::cpu_load()
+ * @see os::rtos::scheduler::statistics::idle_cpu_load()
+ *
+ * @par Default
+ * Disable. Do not include CPU load statistics.
+ */
+#define OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD
+
+/**
+ * @brief Define the duration of the CPU load windows.
+ *
+ * @details
+ * The duration, in SysTick ticks, of each window used to
+ * compute the threads CPU load.
+ *
+ * @par Default
+ * One second (@ref OS_INTEGER_SYSTICK_FREQUENCY_HZ ticks).
+ */
+#define OS_INTEGER_RTOS_STATISTICS_CPU_LOAD_WINDOW_TICKS	(1000)
+
 /**
  * @brief Add a user defined storage to each thread.
  */
@@ -472,6 +572,447 @@
  */
 #define OS_BOOL_RTOS_SCHEDULER_PREEMPTIVE (true)
 
+/**
+ * @brief Use an array of lists for the ready threads.
+ *
+ * @details
+ * By default, the ready threads are kept in a single list
+ * ordered by priorities, which requires a partial list traversal
+ * each time a thread becomes ready.
+ *
+ * With this option, the ready threads are kept in an array
+ * of FIFO lists, one for each priority, and a bitmap
+ * identifies the non empty lists, so both inserting a thread
+ * and selecting the top priority thread take constant time.
+ *
+ * The RAM overhead is 256 list heads and 9 words for the bitmap.
+ *
+ * @par Default
+ *  Disabled (use a single ordered list).
+ */
+#define OS_INCLUDE_RTOS_READY_LIST_PRIORITY_ARRAY
+
+/**
+ * @brief Defer linking threads resumed from interrupts.
+ *
+ * @details
+ * By default, when an interrupt handler posts a semaphore, raises
+ * flags, etc, the resumed thread is linked to the ready list
+ * inside an interrupts critical section, so the time the
+ * interrupts are disabled depends on the length of the ready list.
+ *
+ * With this option, interrupt handlers only push the thread to
+ * a lock free list, and the threads are linked to the ready list,
+ * in batch, during the next context switch.
+ *
+ * The RAM overhead is a pointer and a flag for each thread.
+ *
+ * @par Default
+ *  Disabled (threads are linked by the interrupt handlers).
+ */
+#define OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME
+
+/**
+ * @brief Suppress the SysTick interrupts while idle.
+ *
+ * @details
+ * By default, the SysTick interrupt fires at
+ * `OS_INTEGER_SYSTICK_FREQUENCY_HZ`, even when the next
+ * timestamp is far away, regularly waking the device from
+ * the idle thread.
+ *
+ * With this option, the idle thread computes the number of ticks up
+ * to the earliest timestamp in the `sysclock` and `hrclock` lists,
+ * and calls `port::clock_systick::suppress_ticks_and_sleep()`,
+ * which must be implemented by the port.
+ * On wake up, the clocks are advanced with the number of
+ * ticks elapsed.
+ *
+ * @par Default
+ *  Disabled (the SysTick interrupt is never suppressed).
+ */
+#define OS_INCLUDE_RTOS_TICKLESS_IDLE
+
+/**
+ * @brief Use a timing wheel for the clock time stamps.
+ *
+ * @details
+ * By default, the clocks keep the timeouts and the timers in lists
+ * ordered by time stamps, which require a partial list traversal
+ * each time a timeout or a timer is armed.
+ *
+ * With this option, the time stamps are kept in a hashed
+ * timing wheel, an array of 32 unordered lists, so arming a
+ * timeout or a timer takes constant time, and the expired nodes
+ * are processed in a batch at each clock tick.
+ *
+ * The RAM overhead is 32 list heads for each clock list.
+ *
+ * @par Default
+ *  Disabled (use ordered lists).
+ */
+#define OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL
+
+/**
+ * @brief Rotate the ready threads with the same priority.
+ *
+ * @details
+ * With this option, each thread gets a time slice when scheduled;
+ * when the running thread uses its entire time slice, the SysTick
+ * handler requests a context switch, and the thread is
+ * re-linked behind the other ready threads with the same
+ * priority.
+ *
+ * The time slice can be set for each thread, either via the
+ * `th_quantum_ticks` attribute or via `thread::quantum(clock::duration_t)`;
+ * if not set, `OS_INTEGER_RTOS_ROUND_ROBIN_QUANTUM_TICKS` is used.
+ *
+ * The number of expired time slices is available via
+ * `scheduler::statistics::quantum_expirations()`.
+ *
+ * @par Default
+ *  Disabled (a context switch is requested on each SysTick).
+ */
+#define OS_INCLUDE_RTOS_ROUND_ROBIN
+
+/**
+ * @brief Default time slice for round robin scheduling, in ticks.
+ *
+ * @details
+ * Used for threads that do not define their own time slice,
+ * when `OS_INCLUDE_RTOS_ROUND_ROBIN` is defined.
+ *
+ * @par Default
+ *  10 ticks.
+ */
+#define OS_INTEGER_RTOS_ROUND_ROBIN_QUANTUM_TICKS (10)
+
+/**
+ * @brief Include the earliest deadline first scheduling class.
+ *
+ * @details
+ * Add support for threads scheduled by the earliest deadline first
+ * (EDF) policy. Such threads declare a relative deadline and/or
+ * a period, via `thread::attributes` or `thread::deadline()`;
+ * each time they are woken up, their absolute deadline is computed,
+ * and the ready threads in this class are ordered by these
+ * deadlines.
+ *
+ * The EDF class is placed above all priorities; threads
+ * with no deadline and no period are scheduled by priority,
+ * only when no EDF thread is ready.
+ *
+ * With EDF, periodic threads can use up to the entire CPU time and
+ * still meet their deadlines, while with static priorities
+ * assigned as rate monotonic the guaranteed utilisation is lower.
+ *
+ * @par Default
+ * Disable. All threads are scheduled by priority.
+ */
+#define OS_INCLUDE_RTOS_EDF_SCHEDULING
+
+/**
+ * @brief Defer the context switches requested while the scheduler is locked.
+ *
+ * @details
+ * When threads are resumed while the scheduler is locked, the
+ * request for a context switch is only remembered; when the scheduler
+ * is unlocked, a single context switch is performed, regardless
+ * how many threads were resumed.
+ *
+ * The functions that resume all waiting threads (like
+ * `condition_variable::broadcast()` or `event_flags::raise()`) lock
+ * the scheduler while resuming them, so a broadcast results in
+ * one context switch, not one for each thread.
+ *
+ * @par Default
+ * Disable. Each resumed thread requests a separate context switch.
+ */
+#define OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE
+
+/**
+ * @brief Use per core ready lists, for multi-core devices.
+ *
+ * @details
+ * Each core has its own running thread, its own ready list and its
+ * own idle thread. Threads are linked to the ready list of the core
+ * they last ran on, and a core performing a context switch may steal
+ * the head of another core ready list, if it is better than its own
+ * and the thread affinity allows it.
+ *
+ * Thread affinity masks are set with the `th_affinity` attribute
+ * or with `thread::affinity (affinity_t)`.
+ *
+ * The boot core starts the scheduler with `scheduler::start()`;
+ * each secondary core must then call `scheduler::start_core()`,
+ * which makes the best thread allowed on that core, at worst its
+ * idle thread, the core running thread.
+ *
+ * The port must implement `port::scheduler::core_id()`, the
+ * `port::scheduler::lock_cores()` and
+ * `port::scheduler::unlock_cores()` spin lock, and
+ * `port::scheduler::reschedule_core()`, used when a thread is
+ * linked to the ready list of another core.
+ *
+ * The outer `interrupts::critical_section` of each core also holds
+ * the lock shared by all cores, so all kernel lists (the ready lists,
+ * the waiting lists of the synchronisation objects, the clock lists)
+ * are protected from the other cores, without changes in the
+ * objects code.
+ *
+ * @par Default
+ * Disable. A single ready list is used.
+ */
+#define OS_INCLUDE_RTOS_SCHEDULER_SMP
+
+/**
+ * @brief The number of cores managed by the scheduler.
+ *
+ * @details
+ * Used only when `OS_INCLUDE_RTOS_SCHEDULER_SMP` is defined;
+ * must be between 1 and 32.
+ *
+ * @par Default
+ * 2.
+ */
+#define OS_INTEGER_RTOS_SCHEDULER_CORES (2)
+
+/**
+ * @brief Track the maximum stack usage of each thread.
+ *
+ * @details
+ * Add `thread::stack::high_water_mark()`, which remembers the lowest
+ * overwritten stack element and rescans only up to it, and
+ * `thread::stack::report()`, which displays the maximum stack usage
+ * of all threads on the trace channel.
+ *
+ * @par Default
+ * Disable. Only the full scan `thread::stack::available()` is provided.
+ */
+#define OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK
+
+/**
+ * @brief Add thread specific data keys.
+ *
+ * @details
+ * Each thread has an array of `OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS` values,
+ * accessed in constant time with keys created by
+ * `thread::specific_key_create()`, similar to POSIX
+ * `pthread_key_create()`. The key destructors are called with the
+ * non null values when threads are destroyed.
+ *
+ * @par Default
+ * Disable.
+ */
+#define OS_INCLUDE_RTOS_THREAD_SPECIFIC
+
+/**
+ * @brief The number of thread specific data keys.
+ *
+ * @details
+ * Used only when `OS_INCLUDE_RTOS_THREAD_SPECIFIC` is defined;
+ * must be between 1 and 32.
+ *
+ * @par Default
+ * 8.
+ */
+#define OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS
+
+/**
+ * @brief Add multiple objects waits.
+ *
+ * @details
+ * Add `this_thread::wait_any()` and its variants, which suspend
+ * the current thread on several semaphores, message queues,
+ * event flags and the thread flags at once, and return the index
+ * of the source that fired.
+ *
+ * Requires the portable scheduler and objects.
+ *
+ * @par Default
+ * Disable.
+ */
+#define OS_INCLUDE_RTOS_THREAD_WAIT_ANY
+
+/**
+ * @brief Check the thread stack on each context switch.
+ *
+ * @details
+ * When switching threads, validate the bottom canary of the
+ * outgoing thread stack and the saved stack pointer against the stack
+ * limits, and call `os_rtos_thread_stack_overflow_hook()` if
+ * they are not valid.
+ *
+ * The cost is a few loads per context switch; the port must
+ * implement `port::scheduler::saved_stack_pointer()`.
+ *
+ * @par Default
+ * Disable.
+ */
+#define OS_INCLUDE_RTOS_THREAD_STACK_GUARD
+
+/**
+ * @brief Limit the thread CPU time.
+ *
+ * @details
+ * Threads may have a CPU budget, in `hrclock` cycles, for each
+ * period, in SysTick ticks; when the budget is used, the thread
+ * is suspended until the next period.
+ *
+ * Requires `OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES`.
+ *
+ * @par Default
+ * Disable.
+ */
+#define OS_INCLUDE_RTOS_THREAD_CPU_BUDGET
+
+/**
+ * @brief Save the floating point registers only for threads using them.
+ *
+ * @details
+ * Each thread has a flag telling if the floating point registers
+ * are part of its context; it is set from the `th_fpu_used`
+ * attribute, or by the scheduler, when the port function
+ * `port::scheduler::saved_fpu_context()` reports that the context
+ * saved for the outgoing thread includes the floating point
+ * registers (for example on Cortex-M, from the EXC_RETURN value).
+ *
+ * The scheduler calls `port::scheduler::save_fpu_context()` and
+ * `port::scheduler::restore_fpu_context()` only for threads with
+ * `thread::fpu_used()` true, so integer only threads have shorter
+ * context switches.
+ *
+ * @par Default
+ * Disable.
+ */
+#define OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT
+
+/**
+ * @brief Destroy the terminated threads in a dedicated thread.
+ *
+ * @details
+ * Normally the terminated threads are destroyed by the idle
+ * thread, which, under sustained load, may not run for long
+ * periods, so the stacks of the terminated threads are
+ * not deallocated and their joiners are not resumed.
+ *
+ * With this option, each exiting thread wakes up a **reaper**
+ * thread, running with `thread::priority::above_normal`,
+ * which destroys it promptly; the idle thread remains a fallback.
+ *
+ * @par Default
+ * Disable.
+ */
+#define OS_INCLUDE_RTOS_THREAD_REAPER
+
+/**
+ * @brief Add a snapshot of all threads.
+ *
+ * @details
+ * Add `scheduler::threads_snapshot()`, which copies the name, state,
+ * priority, stack usage and statistics of all threads into a
+ * caller buffer, keeping the scheduler locked only while copying
+ * chunks of `OS_INTEGER_RTOS_THREAD_SNAPSHOT_CHUNK` threads.
+ *
+ * @par Default
+ * Disable.
+ */
+#define OS_INCLUDE_RTOS_THREAD_SNAPSHOT
+
+/**
+ * @brief Define the number of threads copied with the scheduler locked.
+ *
+ * @details
+ * Used only when `OS_INCLUDE_RTOS_THREAD_SNAPSHOT` is defined.
+ *
+ * @par Default
+ * 4.
+ */
+#define OS_INTEGER_RTOS_THREAD_SNAPSHOT_CHUNK (4)
+
+/**
+ * @brief Define the size of the thread names copied by the snapshot.
+ *
+ * @details
+ * Used only when `OS_INCLUDE_RTOS_THREAD_SNAPSHOT` is defined;
+ * the size includes the terminating null character, longer names
+ * are truncated.
+ *
+ * @par Default
+ * 16.
+ */
+#define OS_INTEGER_RTOS_THREAD_SNAPSHOT_NAME_SIZE
+
+/**
+ * @brief Execute the timer functions in a dedicated thread.
+ *
+ * @details
+ * Normally the timer functions are called directly from the
+ * clock interrupt, so a slow function delays all other timers
+ * and timeouts.
+ *
+ * With this option, the clock interrupt only queues the expired
+ * timers and wakes up a **timer daemon** thread, running with
+ * `OS_INTEGER_RTOS_TIMER_DAEMON_PRIORITY`, which calls all
+ * queued functions. Expirations that occur while the previous
+ * call is still queued are counted by `timer::overruns()`.
+ *
+ * @par Default
+ * Disable.
+ */
+#define OS_INCLUDE_RTOS_TIMER_DAEMON
+
+/**
+ * @brief Add drift free periodic sleeps.
+ *
+ * @details
+ * Add `clock::sleep_until_next_period()`, which keeps, for each
+ * thread, the timestamp of the next release and advances it by
+ * exactly one period on each call, so that periodic loops
+ * do not accumulate drift; missed releases are skipped and reported.
+ *
+ * @par Default
+ * Disable.
+ */
+#define OS_INCLUDE_RTOS_THREAD_PERIODIC_SLEEP
+
+/**
+ * @brief Allow timers and timeouts to be coalesced.
+ *
+ * @details
+ * Add the `timer::attributes::tm_slack` and `thread::attributes::th_slack`
+ * attributes, and `thread::slack()`. Timers and timed waits with a
+ * non zero slack may expire later by up to this duration; the
+ * time stamp is moved to the value in the window with most trailing
+ * zero bits, so expiries with overlapping windows are handled in the
+ * same clock check, reducing the number of wake-ups, especially with
+ * `OS_INCLUDE_RTOS_TICKLESS_IDLE`.
+ *
+ * @par Default
+ * Disable.
+ */
+#define OS_INCLUDE_RTOS_CLOCK_SLACK
+
+/**
+ * @brief Read the clock counters without critical sections.
+ *
+ * @details
+ * The clock counters are 64-bit wide, and on 32-bit cores
+ * `clock::now()`, `clock::steady_now()` and `clock_highres::now()`
+ * read them in a critical section. With this option the tick
+ * interrupt and the other writers, still in critical sections,
+ * maintain a sequence number, odd while updating, and the readers
+ * retry until they see the same even number before and after
+ * reading the counters, so timestamping does not disable interrupts.
+ *
+ * The high resolution port `cycles_since_tick()` must be safe
+ * to call with interrupts enabled.
+ *
+ * @par Default
+ * Disable.
+ */
+#define OS_INCLUDE_RTOS_CLOCK_SEQLOCK
+
 /**
  * @brief Do not enter sleep in the idle thread.
  *
@@ -656,6 +1197,23 @@
  */
 #define OS_USE_RTOS_PORT_CLOCK_REALTIME_WAIT_FOR
 
+/**
+ * @brief Use the port high resolution compare match.
+ *
+ * @details
+ * The port implements `port::clock_highres::arm_compare()` and calls
+ * `os_hrclock_compare_handler()` from the compare interrupt; the
+ * `hrclock` timers and timeouts due between ticks then expire at the
+ * programmed cycle, not at the next tick.
+ *
+ * Without it, the `hrclock` time stamps are checked only on ticks.
+ *
+ * The earliest time stamp is taken from the head of the ordered
+ * clock list, so it cannot be used with
+ * `OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL`.
+ */
+#define OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE
+
 /**
  * @brief Use a custom timer implementation.
  */
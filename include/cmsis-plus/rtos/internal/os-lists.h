@@ -120,6 +120,21 @@ namespace os
 
       // ======================================================================
 
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK)
+
+      /**
+       * @brief Move a time stamp later, to coalesce it with others.
+       * @param [in] timestamp The time stamp.
+       * @param [in] slack How much later the time stamp may be moved.
+       * @return The time stamp in the _slack_ window with the
+       *  most trailing zero bits.
+       */
+      port::clock::timestamp_t
+      coalesced_timestamp (port::clock::timestamp_t timestamp,
+                           port::clock::duration_t slack);
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) */
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wpadded"
 
@@ -383,6 +398,98 @@ namespace os
 
 #pragma GCC diagnostic pop
 
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+
+      // ======================================================================
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+      /**
+       * @brief Double linked list node, with time stamp and throttled thread.
+       */
+      class budget_thread_node : public timestamp_node
+      {
+      public:
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a budget replenishment node.
+         * @param [in] th Reference to thread.
+         */
+        budget_thread_node (rtos::thread& th);
+
+        /**
+         * @cond ignore
+         */
+
+        budget_thread_node (const budget_thread_node&) = delete;
+        budget_thread_node (budget_thread_node&&) = delete;
+        budget_thread_node&
+        operator= (const budget_thread_node&) = delete;
+        budget_thread_node&
+        operator= (budget_thread_node&&) = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the node.
+         */
+        virtual
+        ~budget_thread_node ();
+
+        /**
+         * @}
+         */
+
+      public:
+
+        /**
+         * @name Public Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Action to perform when the time stamp is reached.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         */
+        virtual void
+        action (void) override;
+
+        /**
+         * @}
+         */
+
+      public:
+
+        /**
+         * @name Public Member Variables
+         * @{
+         */
+
+        /**
+         * @brief Reference to throttled thread.
+         */
+        rtos::thread& thread;
+
+        /**
+         * @}
+         */
+      };
+
+#pragma GCC diagnostic pop
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
       // ======================================================================
 
       /**
@@ -454,7 +561,10 @@ namespace os
       /**
        * @brief Priority ordered list of threads waiting too run.
        */
-      class ready_threads_list : public utils::static_double_list
+      class ready_threads_list
+#if !defined(OS_INCLUDE_RTOS_READY_LIST_PRIORITY_ARRAY)
+          : public utils::static_double_list
+#endif
       {
       public:
 
@@ -526,11 +636,206 @@ namespace os
         thread*
         unlink_head (void);
 
+#if defined(OS_INCLUDE_RTOS_READY_LIST_PRIORITY_ARRAY) \
+  || defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+
+        /**
+         * @brief Check if the list is empty.
+         * @par Parameters
+         *  None.
+         * @retval true The list has no nodes.
+         * @retval false The list has at least one node.
+         */
+        bool
+        empty (void) const;
+
+#endif /* defined(OS_INCLUDE_RTOS_READY_LIST_PRIORITY_ARRAY) || defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
         // TODO add iterator begin(), end()
 
         /**
          * @}
          */
+
+      protected:
+
+        /**
+         * @cond ignore
+         */
+
+        /**
+         * @brief Mark the thread of a newly linked node as ready.
+         * @param [in] node Reference to a list node.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        set_ready_ (waiting_thread_node& node);
+
+        /**
+         * @endcond
+         */
+
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+
+        /**
+         * @cond ignore
+         */
+
+        /**
+         * @brief List of ready threads ordered by absolute deadline.
+         */
+        class deadline_list : public utils::static_double_list
+        {
+        public:
+
+          /**
+           * @brief Add a node, after the nodes with earlier or
+           * equal deadlines.
+           * @param [in] node Reference to a list node.
+           * @par Returns
+           *  Nothing.
+           */
+          void
+          link (waiting_thread_node& node);
+        };
+
+        /**
+         * @brief Add the node to the deadline list, if the thread
+         * is in the EDF class.
+         * @param [in] node Reference to a list node.
+         * @retval true The node was added to the deadline list.
+         * @retval false The thread is scheduled by priority.
+         */
+        bool
+        link_deadline_ (waiting_thread_node& node);
+
+        /**
+         * @brief Remove the thread with the earliest deadline.
+         * @par Parameters
+         *  None.
+         * @return Pointer to thread, or `nullptr` if no thread
+         *  in the EDF class is ready.
+         */
+        thread*
+        unlink_deadline_head_ (void);
+
+        /**
+         * @endcond
+         */
+
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
+#if defined(OS_INCLUDE_RTOS_READY_LIST_PRIORITY_ARRAY)
+
+      protected:
+
+        /**
+         * @cond ignore
+         */
+
+        /**
+         * @brief FIFO list of ready threads with the same priority.
+         */
+        class level_list : public utils::static_double_list
+        {
+        public:
+
+          /**
+           * @brief Add a node at the end of the list.
+           * @param [in] node Reference to a list node.
+           * @par Returns
+           *  Nothing.
+           */
+          void
+          link_tail (waiting_thread_node& node);
+        };
+
+        /**
+         * @brief Find the highest level with a set bit.
+         * @par Parameters
+         *  None.
+         * @return The level, or -1 if no bits are set.
+         */
+        int
+        highest_level_ (void) const;
+
+        /**
+         * @brief Clear the level bit, and the group bit if needed.
+         * @param [in] level The level to clear.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        clear_level_ (std::size_t level);
+
+        /**
+         * @endcond
+         */
+
+      protected:
+
+        /**
+         * @name Private Member Variables
+         * @{
+         */
+
+        /**
+         * @brief Number of levels, one for each `thread::priority_t` value.
+         */
+        static constexpr std::size_t levels = 256;
+
+        /**
+         * @brief Number of levels in a bitmap word.
+         */
+        static constexpr std::size_t levels_per_group = 32;
+
+        /**
+         * @brief Number of bitmap words.
+         */
+        static constexpr std::size_t groups = levels / levels_per_group;
+
+        /**
+         * @brief Array of FIFO lists, one for each priority.
+         */
+        level_list lists_[levels];
+
+        /**
+         * @brief One bit for each non empty word in `level_map_`.
+         */
+        uint32_t group_map_;
+
+        /**
+         * @brief One bit for each non empty level.
+         */
+        uint32_t level_map_[groups];
+
+        /**
+         * @}
+         */
+
+#endif /* defined(OS_INCLUDE_RTOS_READY_LIST_PRIORITY_ARRAY) */
+
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+
+      protected:
+
+        /**
+         * @name Private Member Variables
+         * @{
+         */
+
+        /**
+         * @brief Threads in the EDF class, scheduled before all
+         * threads scheduled by priority.
+         */
+        deadline_list edf_list_;
+
+        /**
+         * @}
+         */
+
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
       };
 
       // ======================================================================
@@ -659,7 +964,10 @@ namespace os
       /**
        * @brief Ordered list of time stamp nodes.
        */
-      class clock_timestamps_list : public utils::double_list
+      class clock_timestamps_list
+#if !defined(OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL)
+          : public utils::double_list
+#endif
       {
       public:
 
@@ -722,6 +1030,17 @@ namespace os
         volatile timestamp_node*
         head (void) const;
 
+        /**
+         * @brief Get a time stamp not later than the earliest one.
+         * @par Parameters
+         *  None.
+         * @return A clock time stamp.
+         * @details
+         * Must be called only if the list is not empty.
+         */
+        port::clock::timestamp_t
+        next_timestamp (void) const;
+
         /**
          * @brief Check list time stamps.
          * @param [in] now The current clock time stamp.
@@ -731,9 +1050,121 @@ namespace os
         void
         check_timestamp (port::clock::timestamp_t now);
 
+#if defined(OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL)
+
+        /**
+         * @brief Check if the list is empty.
+         * @par Parameters
+         *  None.
+         * @retval true The list has no nodes.
+         * @retval false The list has at least one node.
+         */
+        bool
+        empty (void) const;
+
+        /**
+         * @brief Set the number of time units covered by each slot.
+         * @param [in] units The number of clock time units.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        slot_units (port::clock::timestamp_t units);
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL) */
+
+        /**
+         * @}
+         */
+
+#if defined(OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL)
+
+      protected:
+
+        /**
+         * @cond ignore
+         */
+
+        /**
+         * @brief Unordered list of time stamp nodes.
+         */
+        class slot_list : public utils::double_list
+        {
+        public:
+
+          /**
+           * @brief Add a node at the end of the list.
+           * @param [in] node Reference to a list node.
+           * @par Returns
+           *  Nothing.
+           */
+          void
+          link_tail (utils::double_list_links& node);
+        };
+
+        /**
+         * @brief Move the expired nodes of a slot to a list.
+         * @param [in] slot The slot index.
+         * @param [in] now The current clock time stamp.
+         * @param [in] expired Reference to the list of expired nodes.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        collect_expired_ (std::size_t slot, port::clock::timestamp_t now,
+                          slot_list& expired);
+
+        /**
+         * @brief Move all nodes to the slots of their time stamps.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        relink_all_ (void);
+
+        /**
+         * @endcond
+         */
+
+      protected:
+
+        /**
+         * @name Private Member Variables
+         * @{
+         */
+
+        /**
+         * @brief Number of slots, one bit for each in `map_`.
+         */
+        static constexpr std::size_t slots = 32;
+
+        /**
+         * @brief Array of lists, indexed by the time stamp modulo `slots`.
+         */
+        slot_list slots_[slots];
+
+        /**
+         * @brief The time stamp units covered by each slot.
+         */
+        port::clock::timestamp_t units_;
+
+        /**
+         * @brief The number of slot periods completely checked.
+         */
+        port::clock::timestamp_t checked_;
+
+        /**
+         * @brief One bit for each non empty slot.
+         */
+        uint32_t map_;
+
         /**
          * @}
          */
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL) */
       };
 
       // ======================================================================
@@ -911,12 +1342,40 @@ namespace os
         ;
       }
 
+#if !defined(OS_INCLUDE_RTOS_READY_LIST_PRIORITY_ARRAY)
+
       inline volatile waiting_thread_node*
       ready_threads_list::head (void) const
       {
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+        if (!edf_list_.empty ())
+          {
+            return static_cast<volatile waiting_thread_node*> (edf_list_.head ());
+          }
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
         return static_cast<volatile waiting_thread_node*> (static_double_list::head ());
       }
 
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+
+      inline bool
+      ready_threads_list::empty (void) const
+      {
+        return edf_list_.empty () && static_double_list::empty ();
+      }
+
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
+#else
+
+      inline bool
+      ready_threads_list::empty (void) const
+      {
+        return head () == nullptr;
+      }
+
+#endif /* !defined(OS_INCLUDE_RTOS_READY_LIST_PRIORITY_ARRAY) */
+
       // ======================================================================
 
       /**
@@ -959,24 +1418,49 @@ namespace os
 
       // ======================================================================
 
+#if !defined(OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL)
+
       inline
       clock_timestamps_list::clock_timestamps_list ()
       {
         ;
       }
 
+#else
+
+      inline
+      clock_timestamps_list::clock_timestamps_list () :
+          units_ (1), //
+          checked_ (0), //
+          map_ (0)
+      {
+        ;
+      }
+
+#endif /* !defined(OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL) */
+
       inline
       clock_timestamps_list::~clock_timestamps_list ()
       {
         ;
       }
 
+#if !defined(OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL)
+
       inline volatile timestamp_node*
       clock_timestamps_list::head (void) const
       {
         return static_cast<volatile timestamp_node*> (double_list::head ());
       }
 
+      inline port::clock::timestamp_t
+      clock_timestamps_list::next_timestamp (void) const
+      {
+        return head ()->timestamp;
+      }
+
+#endif /* !defined(OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL) */
+
       // ======================================================================
 
       /**
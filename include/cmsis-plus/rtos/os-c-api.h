@@ -241,6 +241,31 @@ extern "C"
 
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) \
+  && !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+  /**
+   * @brief Get the idle thread CPU load.
+   * @param [in] windows The number of most recent windows to average.
+   * @return The idle thread CPU load, in per mille.
+   */
+  uint16_t
+  os_sched_stat_get_idle_cpu_load (size_t windows);
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) && !defined(OS_USE_RTOS_PORT_SCHEDULER) */
+
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+  /**
+   * @brief Get the number of time slice expirations.
+   * @return Integer with the number of times a thread used its
+   *  entire time slice since scheduler start.
+   */
+  os_statistics_counter_t
+  os_sched_stat_get_quantum_expirations (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
   /**
    * @}
    */
@@ -553,6 +578,169 @@ extern "C"
   os_result_t
   os_thread_set_priority (os_thread_t* thread, os_thread_prio_t prio);
 
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+  /**
+   * @brief Get the thread time slice.
+   * @param [in] thread Pointer to thread object instance.
+   * @return The number of SysTick ticks.
+   */
+  os_clock_duration_t
+  os_thread_get_quantum (os_thread_t* thread);
+
+  /**
+   * @brief Set the thread time slice.
+   * @param [in] thread Pointer to thread object instance.
+   * @param [in] ticks Number of SysTick ticks; if 0, the default is used.
+   * @retval os_ok The time slice was set.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   */
+  os_result_t
+  os_thread_set_quantum (os_thread_t* thread, os_clock_duration_t ticks);
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+
+  /**
+   * @brief Get the thread EDF relative deadline.
+   * @param [in] thread Pointer to thread object instance.
+   * @return The number of SysTick ticks.
+   */
+  os_clock_duration_t
+  os_thread_get_deadline (os_thread_t* thread);
+
+  /**
+   * @brief Get the thread EDF period.
+   * @param [in] thread Pointer to thread object instance.
+   * @return The number of SysTick ticks.
+   */
+  os_clock_duration_t
+  os_thread_get_period (os_thread_t* thread);
+
+  /**
+   * @brief Set the thread EDF relative deadline and period.
+   * @param [in] thread Pointer to thread object instance.
+   * @param [in] ticks The relative deadline, in SysTick ticks;
+   *  if 0, the period is used.
+   * @param [in] period The period, in SysTick ticks.
+   * @retval os_ok The deadline and period were set.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   */
+  os_result_t
+  os_thread_set_deadline (os_thread_t* thread, os_clock_duration_t ticks,
+                          os_clock_duration_t period);
+
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+  /**
+   * @brief Get the thread core affinity.
+   * @param [in] thread Pointer to thread object instance.
+   * @return The mask of cores the thread is allowed to run on.
+   */
+  os_thread_affinity_t
+  os_thread_get_affinity (os_thread_t* thread);
+
+  /**
+   * @brief Set the thread core affinity.
+   * @param [in] thread Pointer to thread object instance.
+   * @param [in] mask The cores the thread is allowed to run on;
+   *  if 0, all cores.
+   * @retval os_ok The affinity was set.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval EINVAL The mask does not include any existing core.
+   */
+  os_result_t
+  os_thread_set_affinity (os_thread_t* thread, os_thread_affinity_t mask);
+
+  /**
+   * @brief Get the thread core.
+   * @param [in] thread Pointer to thread object instance.
+   * @return The core the thread is running on, or, if not
+   *  running, the core whose ready list it will be added to.
+   */
+  size_t
+  os_thread_get_core (os_thread_t* thread);
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+
+  /**
+   * @brief Get the thread CPU budget.
+   * @param [in] thread Pointer to thread object instance.
+   * @return The number of `hrclock` cycles the thread may run
+   *  in each period, or 0 if not limited.
+   */
+  os_statistics_duration_t
+  os_thread_get_budget (os_thread_t* thread);
+
+  /**
+   * @brief Set the thread CPU budget.
+   * @param [in] thread Pointer to thread object instance.
+   * @param [in] cycles Number of `hrclock` cycles the thread may
+   *  run in each period; if 0, the CPU time is not limited.
+   * @param [in] period_ticks The budget period, in SysTick ticks.
+   * @retval os_ok The budget was set.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval EINVAL The period is 0 for a non zero budget.
+   */
+  os_result_t
+  os_thread_set_budget (os_thread_t* thread, os_statistics_duration_t cycles,
+                        os_clock_duration_t period_ticks);
+
+  /**
+   * @brief Check if the thread is throttled.
+   * @param [in] thread Pointer to thread object instance.
+   * @retval true The thread used its budget and is suspended
+   *  until the next period.
+   * @retval false The thread may run.
+   */
+  bool
+  os_thread_is_throttled (os_thread_t* thread);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT)
+
+  /**
+   * @brief Check if the thread uses the floating point unit.
+   * @param [in] thread Pointer to thread object instance.
+   * @retval true The floating point registers are saved and
+   *  restored with the thread context.
+   * @retval false The thread context includes only the core
+   *  registers.
+   */
+  bool
+  os_thread_is_fpu_used (os_thread_t* thread);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) */
+
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK)
+
+  /**
+   * @brief Get the thread timed waits slack.
+   * @param [in] thread Pointer to thread object instance.
+   * @return How much later the timeouts may expire, in clock units.
+   */
+  os_clock_duration_t
+  os_thread_get_slack (os_thread_t* thread);
+
+  /**
+   * @brief Set the thread timed waits slack.
+   * @param [in] thread Pointer to thread object instance.
+   * @param [in] slack How much later the timeouts may expire,
+   *  in clock units; 0 for exact timeouts.
+   * @retval os_ok The slack was set.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   */
+  os_result_t
+  os_thread_set_slack (os_thread_t* thread, os_clock_duration_t slack);
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) */
+
   /**
    * @brief Wait for thread termination.
    * @param [in] thread Pointer to terminating thread object instance.
@@ -563,6 +751,19 @@ extern "C"
   os_result_t
   os_thread_join (os_thread_t* thread, void** exit_ptr);
 
+  /**
+   * @brief Wait for the termination of multiple threads.
+   * @param [in] threads Array of pointers to thread object instances.
+   * @param [in] count The number of threads.
+   * @param [out] exit_ptrs Array where to store the thread exit
+   *  values. (may be NULL).
+   * @retval os_ok All threads were terminated.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval EINVAL The array is null.
+   */
+  os_result_t
+  os_thread_join_all (os_thread_t* threads[], size_t count, void** exit_ptrs);
+
   /**
    * @brief Resume the thread.
    * @param [in] thread Pointer to thread object instance.
@@ -606,6 +807,54 @@ extern "C"
 
 #endif /* defined(OS_INCLUDE_RTOS_CUSTOM_THREAD_USER_STORAGE) */
 
+#if defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC)
+
+  /**
+   * @brief Get the thread specific value associated with a key.
+   * @param [in] thread Pointer to thread object instance.
+   * @param [in] key The key.
+   * @return The value, or `NULL` if not set or if the key is invalid.
+   */
+  void*
+  os_thread_get_specific (os_thread_t* thread, os_thread_specific_key_t key);
+
+  /**
+   * @brief Associate a thread specific value with a key.
+   * @param [in] thread Pointer to thread object instance.
+   * @param [in] key The key.
+   * @param [in] value The value.
+   * @retval os_ok The value was set.
+   * @retval EINVAL The key is invalid.
+   */
+  os_result_t
+  os_thread_set_specific (os_thread_t* thread, os_thread_specific_key_t key,
+                          void* value);
+
+  /**
+   * @brief Create a thread specific data key.
+   * @param [out] key Pointer to the location where to store the key.
+   * @param [in] destructor Pointer to a function called with
+   *  the non null values when threads are destroyed; may be `NULL`.
+   * @retval os_ok The key was created.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval EAGAIN All keys are in use.
+   */
+  os_result_t
+  os_thread_specific_key_create (os_thread_specific_key_t* key,
+                                 os_thread_specific_destructor_t destructor);
+
+  /**
+   * @brief Delete a thread specific data key.
+   * @param [in] key The key.
+   * @retval os_ok The key was deleted.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval EINVAL The key is invalid.
+   */
+  os_result_t
+  os_thread_specific_key_delete (os_thread_specific_key_t key);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC) */
+
   /**
    * @brief Get the thread context stack.
    * @param [in] thread Pointer to thread object instance.
@@ -703,6 +952,28 @@ extern "C"
   size_t
   os_thread_stack_get_available (os_thread_stack_t* stack);
 
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+
+  /**
+   * @brief Get the maximum stack usage.
+   * @param [in] stack Pointer to stack object instance.
+   * @return Number of bytes used at the deepest point.
+   */
+  size_t
+  os_thread_stack_get_high_water_mark (os_thread_stack_t* stack);
+
+  /**
+   * @brief Display the maximum stack usage of all threads.
+   * @par Parameters
+   *  None.
+   * @par Returns
+   *  Nothing.
+   */
+  void
+  os_thread_stack_report (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
+
   /**
    * @brief Check if bottom magic word is still there.
    * @param [in] stack Pointer to stack object instance.
@@ -755,6 +1026,42 @@ extern "C"
 
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+  /**
+   * @brief Get the thread CPU load.
+   * @param [in] thread Pointer to thread object instance.
+   * @param [in] windows The number of most recent windows to average.
+   * @return The thread CPU load, in per mille.
+   */
+  uint16_t
+  os_thread_stat_get_cpu_load (os_thread_t* thread, size_t windows);
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
+  /**
+   * @brief Get a thread wakeup latency histogram bucket.
+   * @param [in] thread Pointer to thread object instance.
+   * @param [in] bucket The bucket index.
+   * @return A long integer with the number of wakeups accounted
+   * in the bucket.
+   */
+  os_statistics_counter_t
+  os_thread_stat_get_wakeup_latency (os_thread_t* thread, size_t bucket);
+
+  /**
+   * @brief Get the thread maximum wakeup latency.
+   * @param [in] thread Pointer to thread object instance.
+   * @return A long integer with the largest number of high
+   * resolution cycles from wakeup to run.
+   */
+  os_statistics_duration_t
+  os_thread_stat_get_wakeup_latency_max (os_thread_t* thread);
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) */
+
   /**
    * @}
    */
@@ -866,6 +1173,26 @@ extern "C"
   os_result_t
   os_clock_sleep_until (os_clock_t* clock, os_clock_timestamp_t timestamp);
 
+#if defined(OS_INCLUDE_RTOS_THREAD_PERIODIC_SLEEP)
+
+  /**
+   * @brief Sleep until the next release of a periodic thread.
+   * @param [in] clock Pointer to clock object instance.
+   * @param [in] period The period, in clock units (ticks or seconds).
+   * @param [out] overruns Pointer to the number of releases
+   *  missed since the previous call; may be NULL.
+   * @retval ETIMEDOUT The sleep lasted until the next release.
+   * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+   * @retval EINVAL The period is 0.
+   * @retval EINTR The sleep was interrupted.
+   */
+  os_result_t
+  os_clock_sleep_until_next_period (os_clock_t* clock,
+                                    os_clock_duration_t period,
+                                    size_t* overruns);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_PERIODIC_SLEEP) */
+
   /**
    * @brief Timed wait for an event.
    * @param [in] clock Pointer to clock object instance.
@@ -1131,6 +1458,19 @@ extern "C"
   os_result_t
   os_timer_stop (os_timer_t* timer);
 
+#if defined(OS_INCLUDE_RTOS_TIMER_DAEMON)
+
+  /**
+   * @brief Get the number of overruns.
+   * @param [in] timer Pointer to timer object instance.
+   * @return The number of expirations that occurred while
+   *  the previous callback was still waiting to be executed.
+   */
+  size_t
+  os_timer_get_overruns (os_timer_t* timer);
+
+#endif /* defined(OS_INCLUDE_RTOS_TIMER_DAEMON) */
+
   /**
    * @}
    */
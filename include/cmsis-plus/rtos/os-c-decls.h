@@ -88,11 +88,23 @@ extern "C"
     void* thread;
   } os_internal_waiting_thread_node_t;
 
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
   typedef struct os_internal_clock_timestamps_list_s
   {
+#if !defined(OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL)
     os_internal_double_list_links_t links;
+#else
+    os_internal_double_list_links_t slots[32];
+    os_port_clock_timestamp_t units;
+    os_port_clock_timestamp_t checked;
+    uint32_t map;
+#endif /* !defined(OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL) */
   } os_internal_clock_timestamps_list_t;
 
+#pragma GCC diagnostic pop
+
   /**
    * @addtogroup cmsis-plus-rtos-c-core
    * @{
@@ -375,6 +387,43 @@ extern "C"
    */
   typedef uint8_t os_thread_prio_t;
 
+#if defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC)
+
+#if !defined(OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS)
+#define OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS                (8)
+#endif
+
+  /**
+   * @brief Type of thread specific data keys.
+   *
+   * @see os::rtos::thread::specific_key_t
+   */
+  typedef size_t os_thread_specific_key_t;
+
+  /**
+   * @brief Type of thread specific data destructors.
+   *
+   * @see os::rtos::thread::specific_destructor_t
+   */
+  typedef void (*os_thread_specific_destructor_t) (void* value);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC) */
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+  /**
+   * @brief Type of variables holding thread core affinity masks.
+   *
+   * @details
+   * A bit mask, with bit _n_ set if the thread is allowed to
+   * run on core _n_.
+   *
+   * @see os::rtos::thread::affinity_t
+   */
+  typedef uint32_t os_thread_affinity_t;
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
   // --------------------------------------------------------------------------
 
   /**
@@ -419,6 +468,9 @@ extern "C"
 
     void* stack_addr;
     size_t stack_size_bytes;
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+    void* watermark;
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
 
     /**
      * @endcond
@@ -454,7 +506,8 @@ extern "C"
   } os_thread_context_t;
 
 #if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
-  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
+  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) \
+  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
 
   /**
    * @brief Thread statistics.
@@ -480,6 +533,19 @@ extern "C"
     os_statistics_duration_t cpu_cycles;
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+    os_statistics_counter_t wakeup_latency[16];
+    os_statistics_duration_t wakeup_latency_max;
+    os_clock_timestamp_t wakeup_timestamp;
+    bool wakeup_pending;
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+    uint16_t cpu_load[60];
+    os_statistics_duration_t cpu_load_cycles;
+    uint32_t cpu_load_epoch;
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) */
+
     /**
      * @endcond
      */
@@ -545,8 +611,126 @@ extern "C"
      */
     os_thread_prio_t th_priority;
 
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+    /**
+     * @brief Thread time slice, in SysTick ticks.
+     *
+     * @details
+     * If 0, the default is `OS_INTEGER_RTOS_ROUND_ROBIN_QUANTUM_TICKS`.
+     *
+     * A convenient and explicit variant to this attribute
+     * is to call `os_thread_set_quantum()` at the beginning of the thread
+     * function.
+     */
+    os_clock_duration_t th_quantum_ticks;
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+
+    /**
+     * @brief Thread relative deadline, in SysTick ticks.
+     *
+     * @details
+     * If not 0, the thread is scheduled by the earliest deadline
+     * first policy, before all threads scheduled by priority.
+     * If 0, the period is used.
+     */
+    os_clock_duration_t th_deadline_ticks;
+
+    /**
+     * @brief Thread period, in SysTick ticks.
+     *
+     * @details
+     * If both the deadline and the period are 0, the thread
+     * is scheduled by priority.
+     *
+     * A convenient and explicit variant to these attributes
+     * is to call `os_thread_set_deadline()` at the beginning of the thread
+     * function.
+     */
+    os_clock_duration_t th_period_ticks;
+
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+    /**
+     * @brief Thread core affinity mask.
+     *
+     * @details
+     * If 0, the thread is allowed to run on all cores.
+     *
+     * A convenient and explicit variant to this attribute
+     * is to call `os_thread_set_affinity()` at the beginning of the thread
+     * function.
+     */
+    os_thread_affinity_t th_affinity;
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+
+    /**
+     * @brief Thread CPU budget, in `hrclock` cycles per period.
+     *
+     * @details
+     * If 0, the thread CPU time is not limited.
+     *
+     * A convenient and explicit variant to these attributes
+     * is to call `os_thread_set_budget()` at the beginning of the thread
+     * function.
+     */
+    os_statistics_duration_t th_budget_cycles;
+
+    /**
+     * @brief Thread CPU budget period, in SysTick ticks.
+     *
+     * @details
+     * Must not be 0 if the budget is not 0.
+     */
+    os_clock_duration_t th_budget_period_ticks;
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT)
+
+    /**
+     * @brief Thread floating point usage.
+     *
+     * @details
+     * If true, the floating point registers are part of the
+     * thread context from the start.
+     */
+    bool th_fpu_used;
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) */
+
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK)
+
+    /**
+     * @brief Thread timed waits slack, in clock units.
+     */
+    os_clock_duration_t th_slack;
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) */
+
   } os_thread_attr_t;
 
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+
+  typedef struct os_internal_budget_thread_node_s
+  {
+    void* next;
+    void* prev;
+    void* list;
+    os_clock_timestamp_t timestamp;
+    void* thread;
+  } os_internal_budget_thread_node_t;
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
   /**
    * @brief Thread object storage.
    * @headerfile os-c-api.h <cmsis-plus/rtos/os-c-api.h>
@@ -583,6 +767,10 @@ extern "C"
     void* joiner;
     void* waiting_node;
     void* clock_node;
+#if defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY)
+    void* wait_sources;
+    size_t wait_sources_count;
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY) */
     void* clock;
     void* allocator;
     void* allocted_stack_address;
@@ -597,10 +785,57 @@ extern "C"
     os_thread_user_storage_t user_storage; //
 #endif /* defined(OS_INCLUDE_RTOS_CUSTOM_THREAD_USER_STORAGE) */
 
+#if defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC)
+    void* specific[OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS];
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC) */
+
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+    os_clock_duration_t quantum;
+    os_clock_duration_t quantum_left;
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+    os_clock_duration_t deadline;
+    os_clock_duration_t period;
+    os_clock_timestamp_t absolute_deadline;
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+    os_thread_affinity_t affinity;
+    size_t core;
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+    os_statistics_duration_t budget;
+    os_clock_duration_t budget_period;
+    os_statistics_duration_t budget_used;
+    os_clock_timestamp_t budget_replenish;
+    os_internal_budget_thread_node_t budget_node;
+    bool throttled;
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT)
+    bool fpu_used;
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_PERIODIC_SLEEP)
+    os_clock_timestamp_t next_release;
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_PERIODIC_SLEEP) */
+
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK)
+    os_clock_duration_t slack;
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) */
+
+#if defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME)
+    void* deferred_next;
+    bool deferred_pending;
+#endif /* defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME) */
+
 #if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
-  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
+  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) \
+  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
     os_thread_statistics_t statistics;
-#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) */
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) */
 
 #if defined(OS_USE_RTOS_PORT_SCHEDULER)
     os_thread_port_data_t port;
@@ -651,6 +886,9 @@ extern "C"
     os_internal_clock_timestamps_list_t steady_list;
     os_clock_duration_t sleep_count;
     os_clock_timestamp_t steady_count;
+#if defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK)
+    uint32_t sequence;
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK) */
 
     /**
      * @endcond
@@ -755,6 +993,15 @@ extern "C"
      */
     os_timer_type_t tm_type;
 
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK)
+
+    /**
+     * @brief Timer slack, in clock units.
+     */
+    os_clock_duration_t tm_slack;
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) */
+
   } os_timer_attr_t;
 
   /**
@@ -787,6 +1034,14 @@ extern "C"
     os_internal_clock_timer_node_t clock_node;
     os_clock_duration_t period;
 #endif
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK) && !defined(OS_USE_RTOS_PORT_TIMER)
+    os_clock_duration_t slack;
+    os_clock_timestamp_t due;
+#endif
+#if defined(OS_INCLUDE_RTOS_TIMER_DAEMON)
+    os_internal_double_list_links_t pending_links;
+    size_t overruns;
+#endif
 #if defined(OS_USE_RTOS_PORT_TIMER)
     os_timer_port_data_t port_;
 #endif
@@ -1462,6 +1717,16 @@ extern "C"
   void
   os_rtc_handler (void);
 
+#if defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE)
+
+  /**
+   * @brief High resolution clock compare match interrupt handler.
+   */
+  void
+  os_hrclock_compare_handler (void);
+
+#endif /* defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE) */
+
   /**
    * @}
    */
@@ -183,7 +183,7 @@ namespace os
        *  None.
        * @return The clock current steady timestamp (time units from startup).
        */
-      timestamp_t
+      virtual timestamp_t
       steady_now (void);
 
       /**
@@ -207,6 +207,24 @@ namespace os
       virtual result_t
       sleep_until (timestamp_t timestamp);
 
+#if defined(OS_INCLUDE_RTOS_THREAD_PERIODIC_SLEEP) || defined(__DOXYGEN__)
+
+      /**
+       * @brief Sleep until the next release of a periodic thread.
+       * @param [in] period The period, in clock units (ticks or seconds).
+       * @param [out] overruns Pointer to the number of releases
+       *  missed since the previous call; may be nullptr.
+       * @retval ETIMEDOUT The sleep lasted until the next release.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval EINVAL The period is 0.
+       * @retval EINTR The sleep was interrupted.
+       */
+      result_t
+      sleep_until_next_period (duration_t period,
+                               std::size_t* overruns = nullptr);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_PERIODIC_SLEEP) */
+
       /**
        * @brief Timed wait for an event.
        * @param [in] timeout The timeout in clock units.
@@ -281,6 +299,48 @@ namespace os
       internal_wait_until_ (timestamp_t timestamp,
                             internal::clock_timestamps_list& list);
 
+      /**
+       * @brief Mark the start of a counter update.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_begin_update_ (void);
+
+      /**
+       * @brief Mark the end of a counter update.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_end_update_ (void);
+
+#if defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK)
+
+      /**
+       * @brief Start a lock free read of the counters.
+       * @par Parameters
+       *  None.
+       * @return The even sequence number of the read.
+       */
+      uint32_t
+      internal_read_begin_ (void);
+
+      /**
+       * @brief Check if the counters changed during the read.
+       * @param [in] seq The sequence number returned by internal_read_begin_().
+       * @retval true The read must be retried.
+       * @retval false The values read are consistent.
+       */
+      bool
+      internal_read_retry_ (uint32_t seq);
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK) */
+
       /**
        * @endcond
        */
@@ -303,6 +363,15 @@ namespace os
        */
       timestamp_t volatile steady_count_ = 0;
 
+#if defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK)
+
+      /**
+       * @brief Counters update sequence, odd while updating.
+       */
+      uint32_t volatile sequence_ = 0;
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK) */
+
       /**
        * @endcond
        */
@@ -533,6 +602,28 @@ namespace os
         static constexpr clock::duration_t
         ticks_cast (Rep_T microsec);
 
+#if defined(OS_INCLUDE_RTOS_TICKLESS_IDLE)
+
+      /**
+       * @cond ignore
+       */
+
+      /**
+       * @brief Sleep without ticks until the next timestamp.
+       * @par Parameters
+       *  None.
+       * @retval true The device slept and the clocks were updated.
+       * @retval false The next timestamp is too close, nothing done.
+       */
+      bool
+      internal_tickless_sleep (void);
+
+      /**
+       * @endcond
+       */
+
+#endif /* defined(OS_INCLUDE_RTOS_TICKLESS_IDLE) */
+
       /**
        * @}
        */
@@ -762,12 +853,64 @@ namespace os
       virtual timestamp_t
       now (void) override;
 
+#if defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE)
+
+      /**
+       * @brief Tell the current time since startup.
+       * @par Parameters
+       *  None.
+       * @return The number of SysTick input clocks since startup.
+       */
+      virtual timestamp_t
+      steady_now (void) override;
+
+#endif /* defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE) */
+
       uint32_t
       input_clock_frequency_hz (void);
 
       void
       internal_increment_count (void);
 
+#if defined(OS_INCLUDE_RTOS_TICKLESS_IDLE)
+
+      void
+      internal_increment_count (duration_t ticks);
+
+#endif /* defined(OS_INCLUDE_RTOS_TICKLESS_IDLE) */
+
+#if defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE)
+
+      /**
+       * @cond ignore
+       */
+
+      /**
+       * @brief Program a compare match for the earliest time stamp.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_program_compare (void);
+
+      /**
+       * @brief Process the expired time stamps, with cycle resolution.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_check_compare (void);
+
+      /**
+       * @endcond
+       */
+
+#endif /* defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE) */
+
       /**
        * @}
        */
@@ -828,10 +971,73 @@ namespace os
     __attribute__((always_inline))
     clock::internal_increment_count (void)
     {
+      internal_begin_update_ ();
+
       // One more tick count passed.
       ++steady_count_;
+
+      internal_end_update_ ();
+    }
+
+    /**
+     * @details
+     * Must be called in a critical section, which prevents the
+     * local interrupts from seeing an odd sequence number.
+     */
+    inline void
+    __attribute__((always_inline))
+    clock::internal_begin_update_ (void)
+    {
+#if defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK)
+
+      __atomic_store_n (&sequence_, sequence_ + 1, __ATOMIC_RELAXED);
+      // Make the odd sequence visible before the counters change.
+      __atomic_thread_fence (__ATOMIC_RELEASE);
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK) */
     }
 
+    inline void
+    __attribute__((always_inline))
+    clock::internal_end_update_ (void)
+    {
+#if defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK)
+
+      __atomic_store_n (&sequence_, sequence_ + 1, __ATOMIC_RELEASE);
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK) */
+    }
+
+#if defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK)
+
+    /**
+     * @details
+     * An odd sequence number is seen only when a writer on another
+     * core is in the middle of an update, so the wait is short.
+     */
+    inline uint32_t
+    __attribute__((always_inline))
+    clock::internal_read_begin_ (void)
+    {
+      uint32_t seq;
+      while ((seq = __atomic_load_n (&sequence_, __ATOMIC_ACQUIRE)) & 1)
+        {
+          ;
+        }
+      return seq;
+    }
+
+    inline bool
+    __attribute__((always_inline))
+    clock::internal_read_retry_ (uint32_t seq)
+    {
+      // Complete the counters reads before checking the sequence.
+      __atomic_thread_fence (__ATOMIC_ACQUIRE);
+      return __atomic_load_n (&sequence_, __ATOMIC_RELAXED) != seq;
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK) */
+
     inline void
     __attribute__((always_inline))
     clock::internal_check_timestamps (void)
@@ -901,10 +1107,31 @@ namespace os
     __attribute__((always_inline))
     clock_highres::internal_increment_count (void)
     {
+      internal_begin_update_ ();
+
       // Increment the highres count by SysTick divisor.
       steady_count_ += port::clock_highres::cycles_per_tick ();
+
+      internal_end_update_ ();
     }
 
+#if defined(OS_INCLUDE_RTOS_TICKLESS_IDLE)
+
+    inline void
+    __attribute__((always_inline))
+    clock_highres::internal_increment_count (duration_t ticks)
+    {
+      internal_begin_update_ ();
+
+      // Increment the highres count by the number of slept ticks.
+      steady_count_ += static_cast<timestamp_t> (ticks)
+          * port::clock_highres::cycles_per_tick ();
+
+      internal_end_update_ ();
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_TICKLESS_IDLE) */
+
     inline uint32_t
     __attribute__((always_inline))
     clock_highres::input_clock_frequency_hz (void)
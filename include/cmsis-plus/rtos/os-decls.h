@@ -86,6 +86,7 @@ namespace os
     class semaphore;
     class thread;
     class timer;
+    class wait_source;
 
     // ------------------------------------------------------------------------
 
@@ -936,6 +937,122 @@ namespace os
         bool
         preemptive (bool);
 
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+        /**
+         * @brief Get the current core.
+         * @par Parameters
+         *  None.
+         * @return The index of the core executing the call,
+         *  between 0 and `OS_INTEGER_RTOS_SCHEDULER_CORES - 1`.
+         * @details
+         * It is used to select the per core running thread and
+         * ready list; it must be callable from both threads and
+         * Interrupt Service Routines.
+         */
+        std::size_t
+        core_id (void);
+
+        /**
+         * @brief Acquire the lock shared by all cores.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         * @details
+         * Usually a spin lock; it is called by the outer
+         * interrupts critical section of each core, with the
+         * interrupts already disabled, so it only needs to
+         * exclude the other cores.
+         */
+        void
+        lock_cores (void);
+
+        /**
+         * @brief Release the lock shared by all cores.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        unlock_cores (void);
+
+        /**
+         * @brief Request a context switch on another core.
+         * @param [in] core The index of the core.
+         * @par Returns
+         *  Nothing.
+         * @details
+         * Usually an inter-processor interrupt, which makes the
+         * core perform a context switch, as `reschedule()` does
+         * for the current core.
+         */
+        void
+        reschedule_core (std::size_t core);
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_GUARD)
+
+        /**
+         * @brief Get the stack pointer saved for a thread.
+         * @param [in] th Pointer to the thread.
+         * @return The stack pointer saved by `switch_stacks()`.
+         * @details
+         * It is called from `internal_switch_threads()` for the
+         * outgoing thread, after its context was saved.
+         */
+        stack::element_t*
+        saved_stack_pointer (rtos::thread* th);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_GUARD) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT)
+
+        /**
+         * @brief Check if the saved context of a thread includes
+         *  the floating point registers.
+         * @param [in] th Pointer to the thread.
+         * @retval true The floating point registers were saved.
+         * @retval false Only the core registers were saved.
+         * @details
+         * It is called from `internal_switch_threads()` for the
+         * outgoing thread, after its context was saved, as long as
+         * its `fpu_used()` is false; on Cortex-M, for example, it
+         * checks the EXC_RETURN value saved by `switch_stacks()`.
+         */
+        bool
+        saved_fpu_context (rtos::thread* th);
+
+        /**
+         * @brief Save the floating point registers of a thread.
+         * @param [in] th Pointer to the outgoing thread.
+         * @par Returns
+         *  Nothing.
+         * @details
+         * It is called from `internal_switch_threads()` only for
+         * threads with `fpu_used()` true; on devices which stack
+         * the floating point registers together with the core
+         * registers, it may do nothing.
+         */
+        void
+        save_fpu_context (rtos::thread* th);
+
+        /**
+         * @brief Restore the floating point registers of a thread.
+         * @param [in] th Pointer to the incoming thread.
+         * @par Returns
+         *  Nothing.
+         * @details
+         * It is called from `internal_switch_threads()` only for
+         * threads with `fpu_used()` true.
+         */
+        void
+        restore_fpu_context (rtos::thread* th);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) */
+
       } /* namespace scheduler */
 
       // ----------------------------------------------------------------------
@@ -1022,6 +1139,26 @@ namespace os
         static result_t
         wait_for (clock::duration_t ticks);
 
+#if defined(OS_INCLUDE_RTOS_TICKLESS_IDLE)
+
+        /**
+         * @brief Tickless idle implementation hook.
+         * @param [in] ticks Maximum number of ticks to sleep.
+         * @return The number of complete ticks elapsed while sleeping.
+         * @details
+         * It is called from the idle thread, in an interrupts critical
+         * section. It must stop the periodic tick, program a wakeup
+         * after at most _ticks_, wait for an interrupt (returning
+         * immediately if one is already pending), and restart
+         * the periodic tick.
+         *
+         * The elapsed ticks are added to the clocks by the caller.
+         */
+        static clock::duration_t
+        suppress_ticks_and_sleep (clock::duration_t ticks);
+
+#endif /* defined(OS_INCLUDE_RTOS_TICKLESS_IDLE) */
+
         /**
          * @brief SysTick implementation hook.
          * @details
@@ -1071,6 +1208,23 @@ namespace os
 
         static uint32_t
         input_clock_frequency_hz (void);
+
+#if defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE)
+
+        /**
+         * @brief High resolution compare implementation hook.
+         * @param [in] cycles Number of cycles from now, less than
+         *  a tick; always greater than 0.
+         * @details
+         * It is called in an interrupts critical section. It must
+         * program a compare match after _cycles_, replacing any
+         * previous one, and call `os_hrclock_compare_handler()`
+         * from the compare interrupt.
+         */
+        static void
+        arm_compare (clock::duration_t cycles);
+
+#endif /* defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE) */
       };
 
     // ========================================================================
@@ -1161,10 +1315,109 @@ extern "C"
 #define OS_INTEGER_RTOS_IDLE_STACK_SIZE_BYTES               (os::rtos::port::stack::default_size_bytes)
 #endif
 
+#if !defined(OS_INTEGER_RTOS_REAPER_STACK_SIZE_BYTES)
+#define OS_INTEGER_RTOS_REAPER_STACK_SIZE_BYTES             (os::rtos::port::stack::default_size_bytes)
+#endif
+
+#if !defined(OS_INTEGER_RTOS_TIMER_DAEMON_STACK_SIZE_BYTES)
+#define OS_INTEGER_RTOS_TIMER_DAEMON_STACK_SIZE_BYTES       (os::rtos::port::stack::default_size_bytes)
+#endif
+
+#if !defined(OS_INTEGER_RTOS_TIMER_DAEMON_PRIORITY)
+#define OS_INTEGER_RTOS_TIMER_DAEMON_PRIORITY               (os::rtos::thread::priority::high)
+#endif
+
 #if !defined(OS_BOOL_RTOS_SCHEDULER_PREEMPTIVE)
 #define OS_BOOL_RTOS_SCHEDULER_PREEMPTIVE                   (true)
 #endif
 
+#if !defined(OS_INTEGER_RTOS_ROUND_ROBIN_QUANTUM_TICKS)
+#define OS_INTEGER_RTOS_ROUND_ROBIN_QUANTUM_TICKS           (10)
+#endif
+
+#if !defined(OS_INTEGER_RTOS_STATISTICS_CPU_LOAD_WINDOW_TICKS)
+#define OS_INTEGER_RTOS_STATISTICS_CPU_LOAD_WINDOW_TICKS    (OS_INTEGER_SYSTICK_FREQUENCY_HZ)
+#endif
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) \
+  && !defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
+#error "OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD requires OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES"
+#endif
+
+#if !defined(OS_INTEGER_RTOS_SCHEDULER_CORES)
+#define OS_INTEGER_RTOS_SCHEDULER_CORES                     (2)
+#endif
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+#if defined(OS_USE_RTOS_PORT_SCHEDULER)
+#error "OS_INCLUDE_RTOS_SCHEDULER_SMP requires the portable scheduler"
+#endif
+#if (OS_INTEGER_RTOS_SCHEDULER_CORES < 1) || (OS_INTEGER_RTOS_SCHEDULER_CORES > 32)
+#error "OS_INTEGER_RTOS_SCHEDULER_CORES must be between 1 and 32"
+#endif
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if !defined(OS_INTEGER_RTOS_THREAD_SNAPSHOT_CHUNK)
+#define OS_INTEGER_RTOS_THREAD_SNAPSHOT_CHUNK               (4)
+#endif
+
+#if OS_INTEGER_RTOS_THREAD_SNAPSHOT_CHUNK < 1
+#error "OS_INTEGER_RTOS_THREAD_SNAPSHOT_CHUNK must be at least 1"
+#endif
+
+#if !defined(OS_INTEGER_RTOS_THREAD_SNAPSHOT_NAME_SIZE)
+#define OS_INTEGER_RTOS_THREAD_SNAPSHOT_NAME_SIZE           (16)
+#endif
+
+#if OS_INTEGER_RTOS_THREAD_SNAPSHOT_NAME_SIZE < 2
+#error "OS_INTEGER_RTOS_THREAD_SNAPSHOT_NAME_SIZE must be at least 2"
+#endif
+
+#if !defined(OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS)
+#define OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS                (8)
+#endif
+
+#if (OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS < 1) || (OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS > 32)
+#error "OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS must be between 1 and 32"
+#endif
+
+#if defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY)
+#if defined(OS_USE_RTOS_PORT_SCHEDULER) || defined(OS_USE_RTOS_PORT_SEMAPHORE) \
+  || defined(OS_USE_RTOS_PORT_MESSAGE_QUEUE) || defined(OS_USE_RTOS_PORT_EVENT_FLAGS)
+#error "OS_INCLUDE_RTOS_THREAD_WAIT_ANY requires the portable scheduler and objects"
+#endif
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_GUARD) && defined(OS_USE_RTOS_PORT_SCHEDULER)
+#error "OS_INCLUDE_RTOS_THREAD_STACK_GUARD requires the portable scheduler"
+#endif
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+#if defined(OS_USE_RTOS_PORT_SCHEDULER)
+#error "OS_INCLUDE_RTOS_THREAD_CPU_BUDGET requires the portable scheduler"
+#endif
+#if !defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
+#error "OS_INCLUDE_RTOS_THREAD_CPU_BUDGET requires OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES"
+#endif
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) && defined(OS_USE_RTOS_PORT_SCHEDULER)
+#error "OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT requires the portable scheduler"
+#endif
+
+#if defined(OS_INCLUDE_RTOS_THREAD_REAPER) && defined(OS_USE_RTOS_PORT_SCHEDULER)
+#error "OS_INCLUDE_RTOS_THREAD_REAPER requires the portable scheduler"
+#endif
+
+#if defined(OS_INCLUDE_RTOS_TIMER_DAEMON) && defined(OS_USE_RTOS_PORT_TIMER)
+#error "OS_INCLUDE_RTOS_TIMER_DAEMON requires the portable timers"
+#endif
+
+#if defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE) \
+  && defined(OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL)
+#error "OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE requires the ordered clock lists"
+#endif
+
 // ----------------------------------------------------------------------------
 
 #endif /* CMSIS_PLUS_RTOS_OS_DECLS_H_ */
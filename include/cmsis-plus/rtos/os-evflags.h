@@ -312,6 +312,10 @@ namespace os
       os_evflags_port_data_t port_;
 #endif
 
+#if defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY)
+      friend class wait_source;
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY) */
+
       /**
        * @brief The event flags.
        */
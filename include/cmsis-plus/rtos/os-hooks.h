@@ -107,6 +107,26 @@ extern "C"
   void
   os_startup_create_thread_idle (void);
 
+  /**
+   * @brief Create the reaper thread.
+   * @par Parameters
+   *  None.
+   * @par Returns
+   *  Nothing.
+   */
+  void
+  os_startup_create_thread_reaper (void);
+
+  /**
+   * @brief Create the timer daemon thread.
+   * @par Parameters
+   *  None.
+   * @par Returns
+   *  Nothing.
+   */
+  void
+  os_startup_create_thread_timer_daemon (void);
+
   /**
    * @}
    */
@@ -175,6 +195,17 @@ extern "C"
   void
   os_rtos_system_out_of_memory_hook (void);
 
+  struct os_thread_s;
+
+  /**
+   * @brief Hook to handle a thread stack overflow.
+   * @param [in] thread Pointer to the thread with the corrupted stack.
+   * @par Returns
+   *  Nothing.
+   */
+  void
+  os_rtos_thread_stack_overflow_hook (struct os_thread_s* thread);
+
 /**
  * @}
  */
@@ -691,6 +691,10 @@ namespace os
       os_mqueue_port_data_t port_;
 #endif
 
+#if defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY)
+      friend class wait_source;
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY) */
+
       /**
        * @brief Total size of the statically allocated queue storage
        * (from `attr.mq_queue_size_bytes`).
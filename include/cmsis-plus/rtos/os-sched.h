@@ -60,10 +60,22 @@ namespace os
 
 #if !defined(OS_USE_RTOS_PORT_SCHEDULER)
       extern bool is_preemptive_;
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+      extern thread* volatile current_threads_[OS_INTEGER_RTOS_SCHEDULER_CORES];
+      extern internal::ready_threads_list ready_threads_lists_[OS_INTEGER_RTOS_SCHEDULER_CORES];
+#else
       extern thread* volatile current_thread_;
       extern internal::ready_threads_list ready_threads_list_;
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+      extern internal::waiting_threads_list throttled_threads_list_;
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
 #endif /* !defined(OS_USE_RTOS_PORT_SCHEDULER) */
 
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE)
+      extern bool volatile is_reschedule_pending_;
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE) */
+
       extern internal::terminated_threads_list terminated_threads_list_;
 
       /**
@@ -90,6 +102,20 @@ namespace os
       [[noreturn]] void
       start (void);
 
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+      /**
+       * @brief Start the RTOS scheduler on a secondary core.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      [[noreturn]] void
+      start_core (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
       /**
        * @brief Check if the scheduler was started.
        * @par Parameters
@@ -163,6 +189,72 @@ namespace os
       void
       internal_switch_threads (void);
 
+#if !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+      thread* volatile&
+      internal_current_thread (void);
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+      internal::ready_threads_list*
+      internal_select_ready (std::size_t core);
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#endif /* !defined(OS_USE_RTOS_PORT_SCHEDULER) */
+
+      void
+      internal_reschedule (void);
+
+      void
+      internal_destroy_terminated (void);
+
+#if defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) \
+  || defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+
+      thread*
+      internal_next_thread (thread* th);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) || defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE)
+
+      void
+      internal_reschedule_pending (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE) */
+
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+      bool
+      internal_check_quantum (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+
+      bool
+      internal_check_budget (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+      void
+      internal_check_cpu_load (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) */
+
+#if defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME)
+
+      void
+      internal_defer_resume (thread* th);
+
+      void
+      internal_resume_deferred (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME) */
+
       /**
        * @endcond
        */
@@ -474,6 +566,62 @@ namespace os
 
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+#if !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+        /**
+         * @brief Get the idle thread CPU load.
+         * @param [in] windows The number of most recent windows to
+         *  average.
+         * @return The idle thread CPU load, in per mille.
+         */
+        uint16_t
+        idle_cpu_load (std::size_t windows);
+
+#endif /* !defined(OS_USE_RTOS_PORT_SCHEDULER) */
+
+        /**
+         * @cond ignore
+         */
+
+        // The index of the open window.
+        extern uint32_t cpu_load_epoch_;
+        // The sysclock and hrclock timestamps when the window was opened.
+        extern clock::timestamp_t cpu_load_ticks_;
+        extern clock::timestamp_t cpu_load_timestamp_;
+        // Ring with the lengths of the closed windows, in cycles.
+        extern rtos::statistics::duration_t cpu_load_window_cycles_[];
+
+        /**
+         * @endcond
+         */
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) */
+
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+        /**
+         * @brief Get the number of time slice expirations.
+         * @return Integer with the number of times a thread used its
+         *  entire time slice and was rotated behind a ready thread
+         *  with the same priority, since scheduler start.
+         */
+        rtos::statistics::counter_t
+        quantum_expirations (void);
+
+        /**
+         * @cond ignore
+         */
+
+        extern rtos::statistics::counter_t quantum_expirations_;
+
+        /**
+         * @endcond
+         */
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
       } /* namespace statistics */
     } /* namespace scheduler */
 
@@ -489,6 +637,21 @@ namespace os
       bool
       in_handler_mode (void);
 
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+      /**
+       * @cond ignore
+       */
+
+      // Per core nesting of the critical sections.
+      extern std::size_t critical_nesting_[OS_INTEGER_RTOS_SCHEDULER_CORES];
+
+      /**
+       * @endcond
+       */
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
       // ======================================================================
 
       // TODO: define all levels of critical sections
@@ -886,7 +1049,13 @@ namespace os
       inline state_t
       unlock (void)
       {
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE)
+        state_t st = port::scheduler::unlock ();
+        internal_reschedule_pending ();
+        return st;
+#else
         return port::scheduler::unlock ();
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE) */
       }
 
       /**
@@ -903,9 +1072,69 @@ namespace os
       inline state_t
       locked (state_t state)
       {
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE)
+        state_t st = port::scheduler::locked (state);
+        internal_reschedule_pending ();
+        return st;
+#else
         return port::scheduler::locked (state);
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE) */
+      }
+
+      /**
+       * @cond ignore
+       */
+
+#if !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+      /**
+       * @details
+       * Return a reference to the pointer to the thread running
+       * on the current core.
+       *
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      inline thread* volatile&
+      internal_current_thread (void)
+      {
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+        return current_threads_[port::scheduler::core_id ()];
+#else
+        return current_thread_;
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
       }
 
+#endif /* !defined(OS_USE_RTOS_PORT_SCHEDULER) */
+
+      /**
+       * @details
+       * Request a context switch after threads were resumed.
+       *
+       * When the scheduler is locked, the request is only remembered,
+       * and a single context switch is performed when the scheduler
+       * is unlocked, regardless how many threads were resumed
+       * in the meantime.
+       *
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      inline void
+      internal_reschedule (void)
+      {
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE)
+        if (locked ())
+          {
+            is_reschedule_pending_ = true;
+            return;
+          }
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE) */
+
+        port::scheduler::reschedule ();
+      }
+
+      /**
+       * @endcond
+       */
+
       /**
        * @details
        * Lock the scheduler and remember the initial scheduler state.
@@ -1078,6 +1307,29 @@ namespace os
 
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+        /**
+         * @details
+         * Each time the running thread uses its entire time slice,
+         * the scheduler increments this counter and rotates
+         * the thread behind the other ready threads with the same
+         * priority.
+         *
+         * @note This function is available only when
+         * @ref OS_INCLUDE_RTOS_ROUND_ROBIN
+         * is defined.
+         *
+         * @warning Cannot be invoked from Interrupt Service Routines.
+         */
+        inline rtos::statistics::counter_t
+        quantum_expirations (void)
+        {
+          return quantum_expirations_;
+        }
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
       } /* namespace statistics */
 
     } /* namespace scheduler */
@@ -1125,6 +1377,10 @@ namespace os
 
       /**
        * @details
+       * With `OS_INCLUDE_RTOS_SCHEDULER_SMP`, disabling the
+       * interrupts is not enough to exclude the other cores, so
+       * the outer critical section of each core also acquires
+       * the lock shared by all cores.
        *
        * @note Can be invoked from Interrupt Service Routines.
        */
@@ -1132,7 +1388,18 @@ namespace os
       __attribute__((always_inline))
       critical_section::enter (void)
       {
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+        state_t state = port::interrupts::critical_section::enter ();
+
+        // Interrupts are disabled, the core cannot change.
+        if (critical_nesting_[port::scheduler::core_id ()]++ == 0)
+          {
+            port::scheduler::lock_cores ();
+          }
+        return state;
+#else
         return port::interrupts::critical_section::enter ();
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
       }
 
       /**
@@ -1144,6 +1411,12 @@ namespace os
       __attribute__((always_inline))
       critical_section::exit (state_t state)
       {
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+        if (--critical_nesting_[port::scheduler::core_id ()] == 0)
+          {
+            port::scheduler::unlock_cores ();
+          }
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
         port::interrupts::critical_section::exit (state);
       }
 
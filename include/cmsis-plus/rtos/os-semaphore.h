@@ -483,6 +483,10 @@ namespace os
       os_semaphore_port_data_t port_;
 #endif
 
+#if defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY)
+      friend class wait_source;
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY) */
+
       // Constant set during construction.
       const count_t max_value_ = max_count_value;
 
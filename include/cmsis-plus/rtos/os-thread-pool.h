@@ -0,0 +1,488 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef CMSIS_PLUS_RTOS_OS_THREAD_POOL_H_
+#define CMSIS_PLUS_RTOS_OS_THREAD_POOL_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+#include <cmsis-plus/rtos/os-decls.h>
+#include <cmsis-plus/rtos/os-thread.h>
+#include <cmsis-plus/rtos/os-mqueue.h>
+
+#include <type_traits>
+
+// ----------------------------------------------------------------------------
+
+namespace os
+{
+  namespace rtos
+  {
+
+    // ========================================================================
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+    /**
+     * @brief **Thread pool** with parked worker threads.
+     * @headerfile os.h <cmsis-plus/rtos/os.h>
+     * @ingroup cmsis-plus-rtos-thread
+     */
+    class thread_pool : public internal::object_named
+    {
+    public:
+
+      /**
+       * @brief Type of work functions.
+       * @param [in] args Pointer to work arguments.
+       * @par Returns
+       *  Nothing.
+       */
+      using func_t = void (*) (void* args);
+
+      /**
+       * @brief Type of work function arguments.
+       */
+      using func_args_t = void*;
+
+      /**
+       * @name Constructors & Destructor
+       * @{
+       */
+
+    protected:
+
+      /**
+       * @cond ignore
+       */
+
+      /**
+       * @brief Construct a thread pool object instance.
+       * @param [in] name Pointer to name.
+       * @param [in] queue Reference to the work queue.
+       * @param [in] workers The number of worker threads.
+       */
+      thread_pool (const char* name, message_queue& queue,
+                   std::size_t workers);
+
+      /**
+       * @endcond
+       */
+
+    public:
+
+      /**
+       * @cond ignore
+       */
+
+      // The rule of five.
+      thread_pool (const thread_pool&) = delete;
+      thread_pool (thread_pool&&) = delete;
+      thread_pool&
+      operator= (const thread_pool&) = delete;
+      thread_pool&
+      operator= (thread_pool&&) = delete;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @brief Destruct the thread pool object instance.
+       */
+      virtual
+      ~thread_pool ();
+
+      /**
+       * @}
+       */
+
+    public:
+
+      /**
+       * @name Public Member Functions
+       * @{
+       */
+
+      /**
+       * @brief Dispatch a work function to the pool.
+       * @param [in] func Pointer to work function.
+       * @param [in] args Pointer to work arguments.
+       * @retval result::ok The work was enqueued.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval EINVAL The function pointer is null.
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      submit (func_t func, func_args_t args = nullptr);
+
+      /**
+       * @brief Try to dispatch a work function to the pool.
+       * @param [in] func Pointer to work function.
+       * @param [in] args Pointer to work arguments.
+       * @retval result::ok The work was enqueued.
+       * @retval EINVAL The function pointer is null.
+       * @retval EWOULDBLOCK The work queue is full.
+       */
+      result_t
+      try_submit (func_t func, func_args_t args = nullptr);
+
+      /**
+       * @brief Dispatch a work function to the pool with timeout.
+       * @param [in] func Pointer to work function.
+       * @param [in] args Pointer to work arguments.
+       * @param [in] timeout The timeout duration.
+       * @retval result::ok The work was enqueued.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval EINVAL The function pointer is null.
+       * @retval ETIMEDOUT The work could not be enqueued before the
+       *  specified timeout expired.
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      timed_submit (func_t func, func_args_t args, clock::duration_t timeout);
+
+      /**
+       * @brief Get the number of worker threads.
+       * @par Parameters
+       *  None.
+       * @return The number of worker threads.
+       */
+      std::size_t
+      workers (void) const;
+
+      /**
+       * @brief Get the number of busy worker threads.
+       * @par Parameters
+       *  None.
+       * @return The number of workers running work functions.
+       */
+      std::size_t
+      busy (void) const;
+
+      /**
+       * @brief Get the number of works waiting for a worker.
+       * @par Parameters
+       *  None.
+       * @return The number of enqueued works.
+       */
+      std::size_t
+      pending (void) const;
+
+      /**
+       * @}
+       */
+
+    protected:
+
+      /**
+       * @cond ignore
+       */
+
+      /**
+       * @brief A work enqueued to the pool.
+       */
+      struct work
+      {
+        func_t func;
+        func_args_t args;
+      };
+
+      /**
+       * @brief The worker threads function.
+       * @param [in] args Pointer to the pool.
+       * @return Nothing.
+       */
+      static void*
+      internal_run_ (void* args);
+
+      /**
+       * @brief Ask all workers to terminate, after the enqueued works.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_stop_ (void);
+
+      /**
+       * @endcond
+       */
+
+    protected:
+
+      /**
+       * @cond ignore
+       */
+
+      message_queue& queue_;
+      std::size_t workers_;
+      std::size_t volatile busy_ = 0;
+
+      /**
+       * @endcond
+       */
+    };
+
+    // ========================================================================
+
+    /**
+     * @brief Template of a **thread pool** with local storage for
+     * the worker threads and the work queue.
+     * @headerfile os.h <cmsis-plus/rtos/os.h>
+     * @ingroup cmsis-plus-rtos-thread
+     * @tparam W Number of worker threads.
+     * @tparam Q Number of works that can be enqueued.
+     * @tparam N Size of the stack of each worker, in bytes.
+     */
+    template<std::size_t W, std::size_t Q,
+        std::size_t N = port::stack::default_size_bytes>
+      class thread_pool_inclusive : public thread_pool
+      {
+      public:
+
+        /**
+         * @brief Local constant based on template definition.
+         */
+        static const std::size_t workers_count = W;
+
+        /**
+         * @brief Local constant based on template definition.
+         */
+        static const std::size_t queue_size = Q;
+
+        /**
+         * @brief Local constant based on template definition.
+         */
+        static const std::size_t stack_size_bytes = N;
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a thread pool object instance.
+         * @param [in] prio The priority of the worker threads.
+         */
+        thread_pool_inclusive (thread::priority_t prio =
+                                   thread::priority::normal);
+
+        /**
+         * @brief Construct a named thread pool object instance.
+         * @param [in] name Pointer to name.
+         * @param [in] prio The priority of the worker threads.
+         */
+        thread_pool_inclusive (const char* name, thread::priority_t prio =
+                                   thread::priority::normal);
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        thread_pool_inclusive (const thread_pool_inclusive&) = delete;
+        thread_pool_inclusive (thread_pool_inclusive&&) = delete;
+        thread_pool_inclusive&
+        operator= (const thread_pool_inclusive&) = delete;
+        thread_pool_inclusive&
+        operator= (thread_pool_inclusive&&) = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the thread pool object instance.
+         */
+        virtual
+        ~thread_pool_inclusive ();
+
+        /**
+         * @}
+         */
+
+      protected:
+
+        /**
+         * @cond ignore
+         */
+
+        using worker_thread = thread_inclusive<N>;
+
+        worker_thread*
+        worker_ (std::size_t index);
+
+        message_queue_inclusive<work, Q> queue_storage_;
+
+        typename std::aligned_storage<sizeof(worker_thread),
+            alignof(worker_thread)>::type threads_[W];
+
+        /**
+         * @endcond
+         */
+      };
+
+#pragma GCC diagnostic pop
+
+  } /* namespace rtos */
+} /* namespace os */
+
+// ===== Inline & template implementations ====================================
+
+namespace os
+{
+  namespace rtos
+  {
+
+    /**
+     * @details
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    thread_pool::workers (void) const
+    {
+      return workers_;
+    }
+
+    /**
+     * @details
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    thread_pool::busy (void) const
+    {
+      return busy_;
+    }
+
+    /**
+     * @details
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    thread_pool::pending (void) const
+    {
+      return queue_.length ();
+    }
+
+    // ========================================================================
+
+    /**
+     * @details
+     * This constructor shall initialise a thread pool object
+     * with the default name.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    template<std::size_t W, std::size_t Q, std::size_t N>
+      inline
+      thread_pool_inclusive<W, Q, N>::thread_pool_inclusive (
+          thread::priority_t prio) :
+          thread_pool_inclusive
+            { nullptr, prio }
+      {
+        ;
+      }
+
+    /**
+     * @details
+     * This constructor shall initialise a named thread pool object,
+     * and create all worker threads, with the given priority,
+     * using the storage inside the object instance.
+     *
+     * The workers are parked waiting on the work queue, so
+     * dispatching a work costs a message queue send, without
+     * any thread creation or stack allocation.
+     *
+     * @note These objects are better instantiated as global static
+     * objects. When instantiated on the thread stack, the stack
+     * should be sized accordingly, including the workers stacks.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    template<std::size_t W, std::size_t Q, std::size_t N>
+      thread_pool_inclusive<W, Q, N>::thread_pool_inclusive (
+          const char* name, thread::priority_t prio) :
+          thread_pool
+            { name, queue_storage_, W }, //
+          queue_storage_
+            { name }
+      {
+        thread::attributes attr = thread::initializer;
+        attr.th_priority = prio;
+
+        for (std::size_t i = 0; i < W; ++i)
+          {
+            // Running the constructor manually allows an array of
+            // threads with attributes.
+            new (&threads_[i]) worker_thread
+              { this->name (), internal_run_, this, attr };
+          }
+      }
+
+    /**
+     * @details
+     * Let the workers complete the enqueued works, wait for
+     * them to terminate and destroy them.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines
+     *  or from one of the workers.
+     */
+    template<std::size_t W, std::size_t Q, std::size_t N>
+      thread_pool_inclusive<W, Q, N>::~thread_pool_inclusive ()
+      {
+        internal_stop_ ();
+
+        for (std::size_t i = 0; i < W; ++i)
+          {
+            worker_ (i)->join ();
+            worker_ (i)->~worker_thread ();
+          }
+      }
+
+    template<std::size_t W, std::size_t Q, std::size_t N>
+      inline typename thread_pool_inclusive<W, Q, N>::worker_thread*
+      thread_pool_inclusive<W, Q, N>::worker_ (std::size_t index)
+      {
+        return reinterpret_cast<worker_thread*> (&threads_[index]);
+      }
+
+  } /* namespace rtos */
+} /* namespace os */
+
+// ----------------------------------------------------------------------------
+
+#endif /* __cplusplus */
+
+#endif /* CMSIS_PLUS_RTOS_OS_THREAD_POOL_H_ */
@@ -206,6 +206,57 @@ namespace os
       flags_get (flags::mask_t mask,
                  flags::mode_t mode = flags::mode::all | flags::mode::clear);
 
+#if defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY) || defined(__DOXYGEN__)
+
+      /**
+       * @brief Wait for any of multiple sources.
+       * @param [in] sources Array of pointers to sources.
+       * @param [in] count The number of sources.
+       * @param [out] index Pointer where to store the index of the
+       *  source that fired; may be `nullptr`.
+       * @retval result::ok One of the sources fired.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval EINVAL The array is empty.
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      wait_any (wait_source* sources[], std::size_t count,
+                std::size_t* index = nullptr);
+
+      /**
+       * @brief Try to wait for any of multiple sources.
+       * @param [in] sources Array of pointers to sources.
+       * @param [in] count The number of sources.
+       * @param [out] index Pointer where to store the index of the
+       *  source that fired; may be `nullptr`.
+       * @retval result::ok One of the sources fired.
+       * @retval EINVAL The array is empty.
+       * @retval EWOULDBLOCK None of the sources fired.
+       */
+      result_t
+      try_wait_any (wait_source* sources[], std::size_t count,
+                    std::size_t* index = nullptr);
+
+      /**
+       * @brief Timed wait for any of multiple sources.
+       * @param [in] sources Array of pointers to sources.
+       * @param [in] count The number of sources.
+       * @param [out] index Pointer where to store the index of the
+       *  source that fired; may be `nullptr`.
+       * @param [in] timeout Timeout to wait, in clock units (ticks or seconds).
+       * @retval result::ok One of the sources fired.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval EINVAL The array is empty.
+       * @retval ETIMEDOUT None of the sources fired during the
+       *  entire timeout duration.
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      timed_wait_any (wait_source* sources[], std::size_t count,
+                      std::size_t* index, clock::duration_t timeout);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY) */
+
       /**
        * @brief Implementation of the library `__errno()` function.
        * @return Pointer to thread specific `errno`.
@@ -330,6 +381,40 @@ namespace os
         };
       }; /* struct priority */
 
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+      /**
+       * @brief Type of variables holding thread core affinity masks.
+       * @details
+       * A bit mask, with bit _n_ set if the thread is allowed to
+       * run on core _n_.
+       * @ingroup cmsis-plus-rtos-thread
+       */
+      using affinity_t = uint32_t;
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC)
+
+      /**
+       * @brief Type of thread specific data keys.
+       * @details
+       * An index in the array of thread specific values.
+       * @ingroup cmsis-plus-rtos-thread
+       */
+      using specific_key_t = std::size_t;
+
+      /**
+       * @brief Type of thread specific data destructors.
+       * @param [in] value The non null value associated with the key.
+       * @par Returns
+       *  Nothing.
+       * @ingroup cmsis-plus-rtos-thread
+       */
+      using specific_destructor_t = void (*) (void* value);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC) */
+
       /**
        * @brief Type of variables holding thread states.
        */
@@ -554,6 +639,19 @@ namespace os
         std::size_t
         available (void);
 
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+
+        /**
+         * @brief Get the maximum stack usage.
+         * @par Parameters
+         *  None.
+         * @return Number of bytes used at the deepest point.
+         */
+        std::size_t
+        high_water_mark (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
+
         /**
          * @}
          */
@@ -599,6 +697,20 @@ namespace os
         static std::size_t
         default_size (std::size_t size_bytes);
 
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+
+        /**
+         * @brief Display the maximum stack usage of all threads.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         */
+        static void
+        report (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
+
         /**
          * @}
          */
@@ -614,6 +726,11 @@ namespace os
         stack::element_t* bottom_address_;
         std::size_t size_bytes_;
 
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+        // The lowest overwritten element found so far, or nullptr.
+        stack::element_t* watermark_;
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
+
         static std::size_t min_size_bytes_;
         static std::size_t default_size_bytes_;
 
@@ -840,6 +957,109 @@ namespace os
          */
         priority_t th_priority = priority::normal;
 
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+        /**
+         * @brief Thread time slice, in SysTick ticks.
+         * @details
+         * If 0, the default is `OS_INTEGER_RTOS_ROUND_ROBIN_QUANTUM_TICKS`.
+         *
+         * A convenient and explicit variant to this attribute
+         * is to call `thread::quantum (clock::duration_t)` at the
+         * beginning of the thread function.
+         */
+        clock::duration_t th_quantum_ticks = 0;
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+
+        /**
+         * @brief Thread relative deadline, in SysTick ticks.
+         * @details
+         * If not 0, the thread is scheduled by the earliest deadline
+         * first policy, before all threads scheduled by priority.
+         * If 0, the period is used.
+         */
+        clock::duration_t th_deadline_ticks = 0;
+
+        /**
+         * @brief Thread period, in SysTick ticks.
+         * @details
+         * If both the deadline and the period are 0, the thread
+         * is scheduled by priority.
+         *
+         * A convenient and explicit variant to these attributes
+         * is to call `thread::deadline (clock::duration_t, clock::duration_t)`
+         * at the beginning of the thread function.
+         */
+        clock::duration_t th_period_ticks = 0;
+
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+        /**
+         * @brief Thread core affinity mask.
+         * @details
+         * If 0, the thread is allowed to run on all cores.
+         *
+         * A convenient and explicit variant to this attribute
+         * is to call `thread::affinity (affinity_t)` at the
+         * beginning of the thread function.
+         */
+        affinity_t th_affinity = 0;
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+
+        /**
+         * @brief Thread CPU budget, in `hrclock` cycles per period.
+         * @details
+         * If 0, the thread CPU time is not limited.
+         *
+         * A convenient and explicit variant to these attributes
+         * is to call `thread::budget (rtos::statistics::duration_t, clock::duration_t)`
+         * at the beginning of the thread function.
+         */
+        rtos::statistics::duration_t th_budget_cycles = 0;
+
+        /**
+         * @brief Thread CPU budget period, in SysTick ticks.
+         * @details
+         * Must not be 0 if the budget is not 0.
+         */
+        clock::duration_t th_budget_period_ticks = 0;
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT)
+
+        /**
+         * @brief Thread floating point usage.
+         * @details
+         * If true, the floating point registers are part of the
+         * thread context from the start; otherwise they are added
+         * only when the port detects the first floating point
+         * instruction.
+         */
+        bool th_fpu_used = false;
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) */
+
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK)
+
+        /**
+         * @brief Thread timed waits slack, in clock units.
+         * @details
+         * The timeouts of the thread may expire later by up to
+         * this duration, to be coalesced with other expiries.
+         */
+        clock::duration_t th_slack = 0;
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) */
+
         // Add more attributes here.
 
         /**
@@ -849,7 +1069,8 @@ namespace os
       }; /* class attributes */
 
 #if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
-  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
+  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) \
+  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
 
       /**
        * @brief Thread statistics.
@@ -930,6 +1151,53 @@ namespace os
 
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
+        /**
+         * @brief Number of buckets in the wakeup latency histogram.
+         */
+        static constexpr std::size_t wakeup_latency_buckets = 16;
+
+        /**
+         * @brief Get a wakeup latency histogram bucket.
+         * @param [in] bucket The bucket index, less than
+         *  wakeup_latency_buckets.
+         * @return A long integer with the number of wakeups
+         * accounted in the bucket.
+         */
+        rtos::statistics::counter_t
+        wakeup_latency (std::size_t bucket);
+
+        /**
+         * @brief Get the maximum wakeup latency.
+         * @par Parameters
+         *  None.
+         * @return A long integer with the largest number of
+         * high resolution cycles from wakeup to run.
+         */
+        rtos::statistics::duration_t
+        wakeup_latency_max (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+        /**
+         * @brief Number of windows kept in the CPU load history.
+         */
+        static constexpr std::size_t cpu_load_windows = 60;
+
+        /**
+         * @brief Get the thread CPU load.
+         * @param [in] windows The number of most recent windows to
+         *  average, between 1 and cpu_load_windows.
+         * @return The thread CPU load, in per mille.
+         */
+        uint16_t
+        cpu_load (std::size_t windows);
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) */
+
         /**
          * @}
          */
@@ -943,6 +1211,24 @@ namespace os
         friend void
         rtos::scheduler::internal_switch_threads (void);
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+        friend class internal::ready_threads_list;
+#if defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME)
+        friend void
+        rtos::scheduler::internal_defer_resume (thread* th);
+#endif /* defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME) */
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+        friend void
+        rtos::scheduler::internal_check_cpu_load (void);
+
+        void
+        internal_roll_cpu_load_ (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) */
+
 #if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES)
         rtos::statistics::counter_t context_switches_ = 0;
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) */
@@ -951,13 +1237,33 @@ namespace os
         rtos::statistics::duration_t cpu_cycles_ = 0;
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+        rtos::statistics::counter_t wakeup_latency_[wakeup_latency_buckets] =
+          { 0 };
+        rtos::statistics::duration_t wakeup_latency_max_ = 0;
+        // The high resolution timestamp when the thread was woken up.
+        clock::timestamp_t wakeup_timestamp_ = 0;
+        // True while the thread waits in the ready list after a wakeup.
+        bool wakeup_pending_ = false;
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+        // Ring of closed windows loads, in per mille.
+        uint16_t cpu_load_[cpu_load_windows] =
+          { 0 };
+        // Cycles accumulated in the open window.
+        rtos::statistics::duration_t cpu_load_cycles_ = 0;
+        // The index of the open window.
+        uint32_t cpu_load_epoch_ = 0;
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) */
+
         /**
          * @endcond
          */
 
       };
 
-#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) */
 
 #pragma GCC diagnostic pop
 
@@ -1096,6 +1402,20 @@ namespace os
       result_t
       join (void** exit_ptr = nullptr);
 
+      /**
+       * @brief Wait for the termination of multiple threads.
+       * @param [in] threads Array of pointers to threads.
+       * @param [in] count The number of threads.
+       * @param [out] exit_ptrs Array where to store the thread exit
+       *  values. (Optional, may be nullptr).
+       * @retval result::ok All threads were terminated.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval EINVAL The array is null.
+       */
+      static result_t
+      join_all (thread* threads[], std::size_t count, void** exit_ptrs =
+                    nullptr);
+
       // Accessors & mutators.
 
       /**
@@ -1138,6 +1458,186 @@ namespace os
       priority_t
       priority_inherited (void);
 
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+      /**
+       * @brief Set the time slice.
+       * @param [in] ticks Number of SysTick ticks; if 0, the default
+       *  `OS_INTEGER_RTOS_ROUND_ROBIN_QUANTUM_TICKS` is used.
+       * @retval result::ok The time slice was set.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       */
+      result_t
+      quantum (clock::duration_t ticks);
+
+      /**
+       * @brief Get the time slice.
+       * @par Parameters
+       *  None.
+       * @return The number of SysTick ticks a thread may run before
+       *  being rotated with other ready threads of the same priority.
+       */
+      clock::duration_t
+      quantum (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+
+      /**
+       * @brief Set the EDF relative deadline and period.
+       * @param [in] ticks The relative deadline, in SysTick ticks;
+       *  if 0, the period is used.
+       * @param [in] period The period, in SysTick ticks.
+       * @retval result::ok The deadline and period were set.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       */
+      result_t
+      deadline (clock::duration_t ticks, clock::duration_t period);
+
+      /**
+       * @brief Get the EDF relative deadline.
+       * @par Parameters
+       *  None.
+       * @return The number of SysTick ticks from the thread wakeup
+       *  to its deadline; 0 if the period is used.
+       */
+      clock::duration_t
+      deadline (void);
+
+      /**
+       * @brief Get the EDF period.
+       * @par Parameters
+       *  None.
+       * @return The number of SysTick ticks between the thread
+       *  releases.
+       */
+      clock::duration_t
+      period (void);
+
+      /**
+       * @brief Get the current absolute deadline.
+       * @par Parameters
+       *  None.
+       * @return The sysclock timestamp of the deadline of the
+       *  current job.
+       */
+      clock::timestamp_t
+      absolute_deadline (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+      /**
+       * @brief Set the thread core affinity.
+       * @param [in] mask The cores the thread is allowed to run on;
+       *  if 0, all cores.
+       * @retval result::ok The affinity was set.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval EINVAL The mask does not include any existing core.
+       */
+      result_t
+      affinity (affinity_t mask);
+
+      /**
+       * @brief Get the thread core affinity.
+       * @par Parameters
+       *  None.
+       * @return The mask of cores the thread is allowed to run on.
+       */
+      affinity_t
+      affinity (void);
+
+      /**
+       * @brief Get the thread core.
+       * @par Parameters
+       *  None.
+       * @return The core the thread is running on, or, if not
+       *  running, the core whose ready list it will be added to.
+       */
+      std::size_t
+      core (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+
+      /**
+       * @brief Set the thread CPU budget.
+       * @param [in] cycles Number of `hrclock` cycles the thread may
+       *  run in each period; if 0, the CPU time is not limited.
+       * @param [in] period_ticks The budget period, in SysTick ticks.
+       * @retval result::ok The budget was set.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval EINVAL The period is 0 for a non zero budget.
+       */
+      result_t
+      budget (rtos::statistics::duration_t cycles,
+              clock::duration_t period_ticks);
+
+      /**
+       * @brief Get the thread CPU budget.
+       * @par Parameters
+       *  None.
+       * @return The number of `hrclock` cycles the thread may run
+       *  in each period, or 0 if not limited.
+       */
+      rtos::statistics::duration_t
+      budget (void);
+
+      /**
+       * @brief Check if the thread is throttled.
+       * @par Parameters
+       *  None.
+       * @retval true The thread used its budget and is suspended
+       *  until the next period.
+       * @retval false The thread may run.
+       */
+      bool
+      throttled (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT)
+
+      /**
+       * @brief Check if the thread uses the floating point unit.
+       * @par Parameters
+       *  None.
+       * @retval true The floating point registers are saved and
+       *  restored with the thread context.
+       * @retval false The thread context includes only the core
+       *  registers.
+       */
+      bool
+      fpu_used (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) */
+
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK)
+
+      /**
+       * @brief Set the timed waits slack.
+       * @param [in] slack How much later the timeouts may expire,
+       *  in clock units; 0 for exact timeouts.
+       * @retval result::ok The slack was set.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       */
+      result_t
+      slack (clock::duration_t slack);
+
+      /**
+       * @brief Get the timed waits slack.
+       * @par Parameters
+       *  None.
+       * @return How much later the timeouts may expire, in clock units.
+       */
+      clock::duration_t
+      slack (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) */
+
 #if 0
       // ???
       result_t
@@ -1212,6 +1712,52 @@ namespace os
 
 #endif /* defined(OS_INCLUDE_RTOS_CUSTOM_THREAD_USER_STORAGE) */
 
+#if defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC)
+
+      /**
+       * @brief Get the thread specific value associated with a key.
+       * @param [in] key The key.
+       * @return The value, or `nullptr` if not set or if the key
+       *  is invalid.
+       */
+      void*
+      specific (specific_key_t key);
+
+      /**
+       * @brief Associate a thread specific value with a key.
+       * @param [in] key The key.
+       * @param [in] value The value.
+       * @retval result::ok The value was set.
+       * @retval EINVAL The key is invalid.
+       */
+      result_t
+      specific (specific_key_t key, void* value);
+
+      /**
+       * @brief Create a thread specific data key.
+       * @param [out] key Pointer to the location where to store the key.
+       * @param [in] destructor Pointer to a function called with
+       *  the non null values when threads are destroyed; may be `nullptr`.
+       * @retval result::ok The key was created.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval EAGAIN All keys are in use.
+       */
+      static result_t
+      specific_key_create (specific_key_t* key,
+                           specific_destructor_t destructor = nullptr);
+
+      /**
+       * @brief Delete a thread specific data key.
+       * @param [in] key The key.
+       * @retval result::ok The key was deleted.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval EINVAL The key is invalid.
+       */
+      static result_t
+      specific_key_delete (specific_key_t key);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC) */
+
       /**
        * @brief Raise thread event flags.
        * @param [in] mask The OR-ed flags to raise.
@@ -1252,7 +1798,8 @@ namespace os
       stack (void);
 
 #if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
-  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
+  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) \
+  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
 
       class thread::statistics&
       statistics (void);
@@ -1325,11 +1872,49 @@ namespace os
       friend void
       scheduler::internal_switch_threads (void);
 
-      friend void
-      port::scheduler::reschedule (void);
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
 
       friend void
-      port::scheduler::start (void);
+      scheduler::start_core (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+      friend bool
+      scheduler::internal_check_quantum (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+
+      friend bool
+      scheduler::internal_check_budget (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+      friend void
+      scheduler::internal_check_cpu_load (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) */
+
+#if defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME)
+
+      friend void
+      scheduler::internal_defer_resume (thread* th);
+
+      friend void
+      scheduler::internal_resume_deferred (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME) */
+
+      friend void
+      port::scheduler::reschedule (void);
+
+      friend void
+      port::scheduler::start (void);
 
       friend port::stack::element_t*
       port::scheduler::switch_stacks (port::stack::element_t* sp);
@@ -1337,6 +1922,17 @@ namespace os
       friend void
       ::os_rtos_idle_actions (void);
 
+      friend void
+      scheduler::internal_destroy_terminated (void);
+
+#if defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) \
+  || defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+
+      friend thread*
+      scheduler::internal_next_thread (thread* th);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) || defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
+
       friend class internal::ready_threads_list;
       friend class internal::thread_children_list;
       friend class internal::waiting_threads_list;
@@ -1347,6 +1943,14 @@ namespace os
       friend class condition_variable;
       friend class mutex;
 
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+      friend class internal::budget_thread_node;
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY)
+      friend class wait_source;
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY) */
+
       /**
        * @endcond
        */
@@ -1522,6 +2126,63 @@ namespace os
       void
       internal_relink_running_ (void);
 
+#if !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+      /**
+       * @brief Get the ready list the thread must be linked to.
+       * @par Parameters
+       *  None.
+       * @return A reference to the ready list.
+       */
+      internal::ready_threads_list&
+      internal_ready_list_ (void);
+
+      /**
+       * @brief Link the thread to its ready list.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_link_ready_ (void);
+
+#endif /* !defined(OS_USE_RTOS_PORT_SCHEDULER) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+
+      /**
+       * @brief Start a new budget period, if the current one ended.
+       * @param [in] now The current sysclock time stamp.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_budget_replenish_ (clock::timestamp_t now);
+
+      /**
+       * @brief Suspend the running thread until the budget
+       *  is replenished.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_budget_throttle_ (void);
+
+      /**
+       * @brief Resume the throttled thread.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_budget_release_ (void);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
       /**
        * @par Parameters
        *  None.
@@ -1589,6 +2250,16 @@ namespace os
       // Pointer to timeout node (stored on stack)
       internal::timeout_thread_node* clock_node_ = nullptr;
 
+#if defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY)
+
+      // Sources of a multiple objects wait (array stored on stack);
+      // their nodes are linked to the objects lists, except the
+      // first one, which is also referred by `waiting_node_`.
+      wait_source* const* wait_sources_ = nullptr;
+      std::size_t wait_sources_count_ = 0;
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY) */
+
       /**
        * @brief Pointer to clock to be used for timeouts.
        */
@@ -1640,11 +2311,110 @@ namespace os
       os_thread_user_storage_t user_storage_;
 #endif /* defined(OS_INCLUDE_RTOS_CUSTOM_THREAD_USER_STORAGE) */
 
-#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES)
+#if defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC)
+
+      // The values associated with the thread specific keys.
+      void* specific_[OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS] =
+        { };
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC) */
+
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+      // The time slice, in ticks.
+      clock::duration_t quantum_ = 0;
+
+      // The ticks left from the current time slice.
+      clock::duration_t volatile quantum_left_ = 0;
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+
+      // The relative deadline and the period, in ticks.
+      clock::duration_t deadline_ = 0;
+      clock::duration_t period_ = 0;
+
+      // The deadline of the current job, in sysclock ticks.
+      clock::timestamp_t absolute_deadline_ = 0;
+
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+      // The mask of cores the thread is allowed to run on.
+      affinity_t affinity_ = 0;
+
+      // The core running the thread, or whose ready list it is linked to.
+      std::size_t core_ = 0;
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+
+      // The CPU budget, in hrclock cycles, and its period, in ticks.
+      rtos::statistics::duration_t budget_ = 0;
+      clock::duration_t budget_period_ = 0;
+
+      // The cycles used in the current period.
+      rtos::statistics::duration_t budget_used_ = 0;
+
+      // The sysclock timestamp when the budget is replenished.
+      clock::timestamp_t budget_replenish_ = 0;
+
+      // Node in the sysclock list, to end the throttling.
+      internal::budget_thread_node budget_node_
+        { *this };
+
+      // True while the thread waits in the throttled list,
+      // linked via `ready_node_`.
+      bool volatile throttled_ = false;
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT)
+
+      // True if the floating point registers are part of the context.
+      // Set from attributes, or by `internal_switch_threads()` when
+      // `port::scheduler::saved_fpu_context()` reports the first
+      // floating point use; the port skips the floating point
+      // registers while false.
+      bool fpu_used_ = false;
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_PERIODIC_SLEEP)
+
+      // The steady timestamp of the next periodic release;
+      // 0 until the first `clock::sleep_until_next_period()`.
+      clock::timestamp_t next_release_ = 0;
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_PERIODIC_SLEEP) */
+
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK)
+
+      // How much later the timeouts may expire.
+      clock::duration_t slack_ = 0;
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) */
+
+#if defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME)
+
+      // Link in the list of threads resumed from interrupts.
+      thread* deferred_next_ = nullptr;
+
+      // True while the thread is in the list of deferred threads.
+      bool deferred_pending_ = false;
+
+#endif /* defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
+  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) \
+  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
 
       class statistics statistics_;
 
-#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) */
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) */
 
       // Add other internal data
 
@@ -1845,6 +2615,157 @@ namespace os
 
       };
 
+    /**
+     * @cond ignore
+     */
+
+    namespace internal
+    {
+      // Number of allocation elements required by the given stack sizes,
+      // each rounded up separately, so that all stacks remain aligned.
+      constexpr std::size_t
+      stack_arena_elements (void)
+      {
+        return 0;
+      }
+
+      template<typename ... T>
+        constexpr std::size_t
+        stack_arena_elements (std::size_t size_bytes, T ... sizes)
+        {
+          return ((size_bytes + sizeof(thread::stack::allocation_element_t) - 1)
+              / sizeof(thread::stack::allocation_element_t))
+              + stack_arena_elements (sizes...);
+        }
+    } /* namespace internal */
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Template of a **stack arena** for statically allocated threads.
+     * @headerfile os.h <cmsis-plus/rtos/os.h>
+     * @ingroup cmsis-plus-rtos-thread
+     *
+     * @tparam Sizes List of stack sizes in bytes, one per thread.
+     *
+     * @details
+     * A single contiguous area, sized at compile time, carved into
+     * one stack for each size in the list. The stacks are
+     * assigned to threads via their attributes, so creating
+     * the threads requires no allocator.
+     */
+    template<std::size_t ... Sizes>
+      class thread_stack_arena
+      {
+      public:
+
+        /**
+         * @brief Local constant with the number of stacks.
+         */
+        static constexpr std::size_t stacks = sizeof...(Sizes);
+
+        /**
+         * @brief Local constant with the total size of the arena, in bytes.
+         */
+        static constexpr std::size_t arena_size_bytes =
+            internal::stack_arena_elements (Sizes...)
+                * sizeof(thread::stack::allocation_element_t);
+
+        static_assert(sizeof...(Sizes) > 0, "The arena must have at least one stack");
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a stack arena object instance.
+         */
+        thread_stack_arena () = default;
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        thread_stack_arena (const thread_stack_arena&) = delete;
+        thread_stack_arena (thread_stack_arena&&) = delete;
+        thread_stack_arena&
+        operator= (const thread_stack_arena&) = delete;
+        thread_stack_arena&
+        operator= (thread_stack_arena&&) = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the stack arena object instance.
+         */
+        ~thread_stack_arena () = default;
+
+        /**
+         * @}
+         */
+
+      public:
+
+        /**
+         * @name Public Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Get the stack address.
+         * @param [in] index Index of the stack in the list.
+         * @return Pointer to the lowest address of the stack.
+         */
+        void*
+        stack_address (std::size_t index);
+
+        /**
+         * @brief Get the stack size.
+         * @param [in] index Index of the stack in the list.
+         * @return The stack size in bytes, rounded up to the
+         *  allocation element size.
+         */
+        std::size_t
+        stack_size_bytes (std::size_t index) const;
+
+        /**
+         * @brief Assign a stack to a thread.
+         * @param [in] index Index of the stack in the list.
+         * @param [in,out] attr Reference to the thread attributes.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        assign (std::size_t index, thread::attributes& attr);
+
+        /**
+         * @}
+         */
+
+      private:
+
+        /**
+         * @cond ignore
+         */
+
+        static constexpr std::size_t elements_[] =
+          { internal::stack_arena_elements (Sizes)... };
+
+        thread::stack::allocation_element_t arena_[internal::stack_arena_elements (
+            Sizes...)];
+
+        /**
+         * @endcond
+         */
+
+      };
+
 #pragma GCC diagnostic pop
 
   } /* namespace rtos */
@@ -2088,6 +3009,9 @@ namespace os
     {
       bottom_address_ = nullptr;
       size_bytes_ = 0;
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+      watermark_ = nullptr;
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
     }
 
     /**
@@ -2101,6 +3025,9 @@ namespace os
       assert (size_bytes >= min_size_bytes_);
       bottom_address_ = address;
       size_bytes_ = size_bytes;
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+      watermark_ = nullptr;
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
     }
 
     /**
@@ -2281,6 +3208,50 @@ namespace os
 
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
+    /**
+     * @details
+     * The wakeup latency is the number of high resolution clock
+     * cycles from the moment the thread is linked to the ready
+     * list, until it is selected to run. Threads re-linked after
+     * being preempted are not accounted.
+     *
+     * The histogram uses a fixed logarithmic scale; bucket 0 counts
+     * latencies below 32 cycles, bucket `n` counts latencies in the
+     * range [2^(n+4), 2^(n+5)) cycles, and the last bucket
+     * counts all latencies starting from 2^19 cycles.
+     *
+     * @note This function is available only when
+     * @ref OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY
+     * is defined.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::counter_t
+    thread::statistics::wakeup_latency (std::size_t bucket)
+    {
+      assert (bucket < wakeup_latency_buckets);
+      return wakeup_latency_[bucket];
+    }
+
+    /**
+     * @details
+     *
+     * @note This function is available only when
+     * @ref OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY
+     * is defined.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::duration_t
+    thread::statistics::wakeup_latency_max (void)
+    {
+      return wakeup_latency_max_;
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) */
+
     // ========================================================================
 
     /**
@@ -2356,12 +3327,224 @@ namespace os
 
 #endif /* defined(OS_INCLUDE_RTOS_CUSTOM_THREAD_USER_STORAGE) */
 
+#if defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC)
+
+    /**
+     * @details
+     * Constant time access, the key is the index in the array
+     * of thread specific values.
+     *
+     * @par POSIX compatibility
+     *  Inspired by [`pthread_getspecific()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_getspecific.html)
+     *  from [`<pthread.h>`](http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/pthread.h.html)
+     *  ([IEEE Std 1003.1, 2013 Edition](http://pubs.opengroup.org/onlinepubs/9699919799/nframe.html)).
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline void*
+    thread::specific (specific_key_t key)
+    {
+      return (key < OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS) ? specific_[key] : nullptr;
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC) */
+
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+    /**
+     * @details
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline clock::duration_t
+    thread::quantum (void)
+    {
+      return quantum_;
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+
+    /**
+     * @details
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline clock::duration_t
+    thread::deadline (void)
+    {
+      return deadline_;
+    }
+
+    /**
+     * @details
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline clock::duration_t
+    thread::period (void)
+    {
+      return period_;
+    }
+
+    /**
+     * @details
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline clock::timestamp_t
+    thread::absolute_deadline (void)
+    {
+      return absolute_deadline_;
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+    /**
+     * @details
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline thread::affinity_t
+    thread::affinity (void)
+    {
+      return affinity_;
+    }
+
+    /**
+     * @details
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    thread::core (void)
+    {
+      return core_;
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+
+    /**
+     * @details
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::duration_t
+    thread::budget (void)
+    {
+      return budget_;
+    }
+
+    /**
+     * @details
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline bool
+    thread::throttled (void)
+    {
+      return throttled_;
+    }
+
+    /**
+     * @cond ignore
+     */
+
+    inline void
+    thread::internal_budget_replenish_ (clock::timestamp_t now)
+    {
+      if (now >= budget_replenish_)
+        {
+          budget_used_ = 0;
+
+          // Keep the periods aligned, unless more were skipped.
+          budget_replenish_ += budget_period_;
+          if (budget_replenish_ <= now)
+            {
+              budget_replenish_ = now + budget_period_;
+            }
+        }
+    }
+
+    /**
+     * @endcond
+     */
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT)
+
+    /**
+     * @details
+     * Once set, the flag is not cleared, since the compiler may use
+     * floating point registers at any time after the first use.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline bool
+    thread::fpu_used (void)
+    {
+      return fpu_used_;
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) */
+
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK)
+
+    /**
+     * @details
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline clock::duration_t
+    thread::slack (void)
+    {
+      return slack_;
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) */
+
 #if !defined(OS_USE_RTOS_PORT_SCHEDULER)
 
     /**
      * @cond ignore
      */
 
+    inline internal::ready_threads_list&
+    thread::internal_ready_list_ (void)
+    {
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+      return rtos::scheduler::ready_threads_lists_[core_];
+#else
+      return rtos::scheduler::ready_threads_list_;
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+    }
+
+    /**
+     * @details
+     * With `OS_INCLUDE_RTOS_SCHEDULER_SMP`, if the list belongs
+     * to another core, that core is notified to reschedule.
+     *
+     * Must be called in a critical section.
+     */
+    inline void
+    thread::internal_link_ready_ (void)
+    {
+      internal_ready_list_ ().link (ready_node_);
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+      if (core_ != port::scheduler::core_id ())
+        {
+          port::scheduler::reschedule_core (core_);
+        }
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+    }
+
     inline void
     thread::internal_relink_running_ (void)
     {
@@ -2372,7 +3555,7 @@ namespace os
           internal::waiting_thread_node& crt_node = ready_node_;
           if (crt_node.next () == nullptr)
             {
-              rtos::scheduler::ready_threads_list_.link (crt_node);
+              internal_link_ready_ ();
               // Ready state set in above link().
             }
 
@@ -2399,7 +3582,9 @@ namespace os
       return context_.stack_;
     }
 
-#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES)
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
+  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) \
+  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
 
     /**
      * @details
@@ -2412,7 +3597,7 @@ namespace os
       return statistics_;
     }
 
-#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) */
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) */
 
 #if defined(OS_INCLUDE_RTOS_THREAD_PUBLIC_FLAGS_CLEAR)
 
@@ -2759,6 +3944,74 @@ namespace os
 #endif
       }
 
+    // ========================================================================
+
+    /**
+     * @cond ignore
+     */
+
+    template<std::size_t ... Sizes>
+      constexpr std::size_t thread_stack_arena<Sizes...>::elements_[];
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @details
+     * The stacks are laid out in the order of the template
+     * arguments, starting from the lowest address of the arena.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    template<std::size_t ... Sizes>
+      void*
+      thread_stack_arena<Sizes...>::stack_address (std::size_t index)
+      {
+        assert (index < stacks);
+
+        std::size_t offset = 0;
+        for (std::size_t i = 0; i < index; ++i)
+          {
+            offset += elements_[i];
+          }
+
+        return &arena_[offset];
+      }
+
+    /**
+     * @details
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    template<std::size_t ... Sizes>
+      inline std::size_t
+      thread_stack_arena<Sizes...>::stack_size_bytes (std::size_t index) const
+      {
+        assert (index < stacks);
+
+        return elements_[index] * sizeof(thread::stack::allocation_element_t);
+      }
+
+    /**
+     * @details
+     * Set the `th_stack_address` and `th_stack_size_bytes` members
+     * of the attributes; a thread constructed with these attributes
+     * uses the arena stack, without calling the allocator.
+     *
+     * It is the application responsibility not to assign the same
+     * stack to multiple threads alive at the same time.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    template<std::size_t ... Sizes>
+      inline void
+      thread_stack_arena<Sizes...>::assign (std::size_t index,
+                                            thread::attributes& attr)
+      {
+        attr.th_stack_address = stack_address (index);
+        attr.th_stack_size_bytes = stack_size_bytes (index);
+      }
+
   } /* namespace rtos */
 } /* namespace os */
 
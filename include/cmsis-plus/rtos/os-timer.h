@@ -41,6 +41,21 @@
 
 // ----------------------------------------------------------------------------
 
+#if defined(OS_INCLUDE_RTOS_TIMER_DAEMON)
+
+/**
+ * @cond ignore
+ */
+
+void*
+os_timer_daemon (void* args);
+
+/**
+ * @endcond
+ */
+
+#endif /* defined(OS_INCLUDE_RTOS_TIMER_DAEMON) */
+
 namespace os
 {
   namespace rtos
@@ -196,6 +211,18 @@ namespace os
          */
         type_t tm_type = run::once;
 
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK)
+
+        /**
+         * @brief Timer slack attribute, in clock units.
+         * @details
+         * The timer may expire later by up to this duration,
+         * to be coalesced with other expiries.
+         */
+        clock::duration_t tm_slack = 0;
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) */
+
         // Add more attributes.
 
         /**
@@ -350,6 +377,20 @@ namespace os
       result_t
       stop (void);
 
+#if defined(OS_INCLUDE_RTOS_TIMER_DAEMON) || defined(__DOXYGEN__)
+
+      /**
+       * @brief Get the number of overruns.
+       * @par Parameters
+       *  None.
+       * @return The number of expirations that occurred while
+       *  the previous callback was still waiting to be executed.
+       */
+      std::size_t
+      overruns (void) const;
+
+#endif /* defined(OS_INCLUDE_RTOS_TIMER_DAEMON) */
+
       /**
        * @}
        */
@@ -367,6 +408,13 @@ namespace os
 
       friend class internal::timer_node;
 
+#if defined(OS_INCLUDE_RTOS_TIMER_DAEMON)
+
+      friend void*
+      ::os_timer_daemon (void* args);
+
+#endif /* defined(OS_INCLUDE_RTOS_TIMER_DAEMON) */
+
       /**
        * @endcond
        */
@@ -422,6 +470,29 @@ namespace os
       clock::duration_t period_ = 0;
 #endif
 
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK) && !defined(OS_USE_RTOS_PORT_TIMER)
+      clock::duration_t slack_ = 0;
+      // The exact expiry time stamp, before coalescing.
+      clock::timestamp_t due_ = 0;
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) && !defined(OS_USE_RTOS_PORT_TIMER) */
+
+#if defined(OS_INCLUDE_RTOS_TIMER_DAEMON)
+
+      // Intrusive node used to link this timer to the daemon list;
+      // only the timer and the daemon (a friend) use it.
+      utils::double_list_links pending_links_;
+
+    public:
+
+      using pending_list = utils::intrusive_list<
+      timer, utils::double_list_links, &timer::pending_links_>;
+
+    protected:
+
+      std::size_t overruns_ = 0;
+
+#endif /* defined(OS_INCLUDE_RTOS_TIMER_DAEMON) */
+
 #if defined(OS_USE_RTOS_PORT_TIMER)
       friend class port::timer;
       os_timer_port_data_t port_;
@@ -495,6 +566,24 @@ namespace os
       return this == &rhs;
     }
 
+#if defined(OS_INCLUDE_RTOS_TIMER_DAEMON)
+
+    /**
+     * @details
+     * When the callbacks are executed by the timer daemon thread,
+     * an expiration that occurs while the previous one was not yet
+     * dispatched is not queued again, but counted as an overrun.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    timer::overruns (void) const
+    {
+      return overruns_;
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_TIMER_DAEMON) */
+
   } /* namespace rtos */
 } /* namespace os */
 
@@ -0,0 +1,297 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef CMSIS_PLUS_RTOS_OS_WAIT_H_
+#define CMSIS_PLUS_RTOS_OS_WAIT_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+#include <cmsis-plus/rtos/os-decls.h>
+#include <cmsis-plus/rtos/os-mqueue.h>
+
+// ----------------------------------------------------------------------------
+
+#if defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY) || defined(__DOXYGEN__)
+
+namespace os
+{
+  namespace rtos
+  {
+
+    // ========================================================================
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+    /**
+     * @brief Source of events for **multiple objects waits**.
+     * @headerfile os.h <cmsis-plus/rtos/os.h>
+     * @ingroup cmsis-plus-rtos-thread
+     * @details
+     * Each source describes an object and the non blocking operation
+     * performed on it when it fires; it also holds the node used to
+     * link the waiting thread to the object waiting list.
+     */
+    class wait_source
+    {
+    public:
+
+      /**
+       * @name Constructors & Destructor
+       * @{
+       */
+
+      /**
+       * @brief Construct a source to decrement a semaphore.
+       * @param [in] sem Reference to the semaphore.
+       */
+      wait_source (semaphore& sem);
+
+      /**
+       * @brief Construct a source to receive from a message queue.
+       * @param [in] mq Reference to the message queue.
+       * @param [out] msg The address where to store the message.
+       * @param [in] nbytes The size of the message buffer.
+       * @param [out] mprio The address where to store the message
+       *  priority; may be `nullptr`.
+       */
+      wait_source (message_queue& mq, void* msg, std::size_t nbytes,
+                   message_queue::priority_t* mprio = nullptr);
+
+      /**
+       * @brief Construct a source to wait for event flags.
+       * @param [in] evf Reference to the event flags.
+       * @param [in] mask The expected flags (OR-ed bit-mask).
+       * @param [out] oflags Pointer where to store the current flags;
+       *  may be `nullptr`.
+       * @param [in] mode Mode bits to select if either all or any flags
+       *  are expected, and if the flags should be cleared.
+       */
+      wait_source (event_flags& evf, flags::mask_t mask,
+                   flags::mask_t* oflags = nullptr,
+                   flags::mode_t mode = flags::mode::all | flags::mode::clear);
+
+      /**
+       * @brief Construct a source to wait for the current thread flags.
+       * @param [in] mask The expected flags (OR-ed bit-mask).
+       * @param [out] oflags Pointer where to store the current flags;
+       *  may be `nullptr`.
+       * @param [in] mode Mode bits to select if either all or any flags
+       *  are expected, and if the flags should be cleared.
+       */
+      wait_source (flags::mask_t mask, flags::mask_t* oflags = nullptr,
+                   flags::mode_t mode = flags::mode::all | flags::mode::clear);
+
+      /**
+       * @cond ignore
+       */
+
+      // The rule of five.
+      wait_source (const wait_source&) = delete;
+      wait_source (wait_source&&) = delete;
+      wait_source&
+      operator= (const wait_source&) = delete;
+      wait_source&
+      operator= (wait_source&&) = delete;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @brief Destruct the source.
+       */
+      ~wait_source ();
+
+      /**
+       * @}
+       */
+
+    protected:
+
+      /**
+       * @cond ignore
+       */
+
+      friend class thread;
+
+      friend result_t
+      this_thread::wait_any (wait_source* sources[], std::size_t count,
+                             std::size_t* index);
+      friend result_t
+      this_thread::try_wait_any (wait_source* sources[], std::size_t count,
+                                 std::size_t* index);
+      friend result_t
+      this_thread::timed_wait_any (wait_source* sources[], std::size_t count,
+                                   std::size_t* index,
+                                   clock::duration_t timeout);
+
+      enum class type
+        : uint8_t
+          {
+            semaphore, //
+        message_queue, //
+        event_flags, //
+        thread_flags
+      };
+
+      /**
+       * @brief Perform the non blocking operation.
+       * @par Parameters
+       *  None.
+       * @retval true The source fired.
+       * @retval false The operation would block.
+       */
+      bool
+      internal_try_ (void);
+
+      /**
+       * @brief Get the object waiting list.
+       * @par Parameters
+       *  None.
+       * @return Pointer to list, or `nullptr` for thread flags.
+       */
+      internal::waiting_threads_list*
+      internal_list_ (void);
+
+      static result_t
+      internal_wait_any_ (wait_source* sources[], std::size_t count,
+                          std::size_t* index, clock::duration_t timeout,
+                          bool blocking, bool timed);
+
+      static void
+      internal_pass_on_ (wait_source* sources[], std::size_t count,
+                         std::size_t except);
+
+      /**
+       * @endcond
+       */
+
+    protected:
+
+      /**
+       * @cond ignore
+       */
+
+      internal::waiting_thread_node node_;
+
+      void* object_;
+      void* msg_ = nullptr;
+      std::size_t nbytes_ = 0;
+      message_queue::priority_t* mprio_ = nullptr;
+      flags::mask_t mask_ = 0;
+      flags::mask_t* oflags_ = nullptr;
+      flags::mode_t mode_ = 0;
+      type type_;
+      // Set when the object removed the node from its list.
+      bool woken_ = false;
+
+      /**
+       * @endcond
+       */
+    };
+
+#pragma GCC diagnostic pop
+
+  } /* namespace rtos */
+} /* namespace os */
+
+// ===== Inline & template implementations ====================================
+
+namespace os
+{
+  namespace rtos
+  {
+    namespace this_thread
+    {
+
+      /**
+       * @details
+       * The sources are checked in the array order, and the first
+       * one that can be satisfied is consumed; if none can,
+       * the calling thread is suspended on all of them, until
+       * one of the objects is posted/sent/raised.
+       *
+       * Only the selected source is consumed; wakeups received
+       * from the other objects are passed to the next waiting thread.
+       *
+       * @warning Cannot be invoked from Interrupt Service Routines.
+       */
+      inline result_t
+      wait_any (wait_source* sources[], std::size_t count, std::size_t* index)
+      {
+        return wait_source::internal_wait_any_ (sources, count, index, 0,
+                                                true, false);
+      }
+
+      /**
+       * @details
+       * Check the sources in the array order and consume the first one
+       * that can be satisfied, without blocking.
+       *
+       * @warning Cannot be invoked from Interrupt Service Routines.
+       */
+      inline result_t
+      try_wait_any (wait_source* sources[], std::size_t count,
+                    std::size_t* index)
+      {
+        return wait_source::internal_wait_any_ (sources, count, index, 0,
+                                                false, false);
+      }
+
+      /**
+       * @details
+       * Similar to `wait_any()`, but the wait is limited by a timeout,
+       * expressed in sysclock ticks.
+       *
+       * As for `semaphore::timed_wait()`, a timeout of 0 is not
+       * forever, the call returns `ETIMEDOUT` at the next tick if
+       * no source can be satisfied.
+       *
+       * @warning Cannot be invoked from Interrupt Service Routines.
+       */
+      inline result_t
+      timed_wait_any (wait_source* sources[], std::size_t count,
+                      std::size_t* index, clock::duration_t timeout)
+      {
+        return wait_source::internal_wait_any_ (sources, count, index,
+                                                timeout, true, true);
+      }
+
+    } /* namespace this_thread */
+  } /* namespace rtos */
+} /* namespace os */
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY) */
+
+// ----------------------------------------------------------------------------
+
+#endif /* __cplusplus */
+
+#endif /* CMSIS_PLUS_RTOS_OS_WAIT_H_ */
@@ -102,6 +102,8 @@
 #include <cmsis-plus/rtos/os-mempool.h>
 #include <cmsis-plus/rtos/os-mqueue.h>
 #include <cmsis-plus/rtos/os-evflags.h>
+#include <cmsis-plus/rtos/os-thread-pool.h>
+#include <cmsis-plus/rtos/os-wait.h>
 
 #include <cmsis-plus/rtos/os-hooks.h>
 
@@ -124,6 +126,17 @@ namespace os
        */
       extern thread::threads_list top_threads_list_;
 
+#if defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) \
+  || defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+
+      /**
+       * @brief Incremented each time a thread is added to or
+       *  removed from the threads tree.
+       */
+      extern uint32_t threads_generation_;
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) || defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
+
       /**
        * @endcond
        */
@@ -136,6 +149,77 @@ namespace os
       thread::threads_list&
       children_threads (thread* th);
 
+#if defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) || defined(__DOXYGEN__)
+
+      /**
+       * @brief Thread information, as copied by `threads_snapshot()`.
+       */
+      struct thread_info
+      {
+        /**
+         * @brief Copy of the thread name; longer names are
+         *  truncated, it is always null terminated.
+         */
+        char name[OS_INTEGER_RTOS_THREAD_SNAPSHOT_NAME_SIZE];
+
+        /**
+         * @brief Stack size, in bytes.
+         */
+        std::size_t stack_size_bytes;
+
+        /**
+         * @brief Maximum stack usage, in bytes.
+         */
+        std::size_t stack_used_bytes;
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) \
+  || defined(__DOXYGEN__)
+
+        /**
+         * @brief Accumulated number of CPU cycles.
+         */
+        rtos::statistics::duration_t cpu_cycles;
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
+  || defined(__DOXYGEN__)
+
+        /**
+         * @brief Number of times the thread was scheduled.
+         */
+        rtos::statistics::counter_t context_switches;
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) */
+
+        /**
+         * @brief Thread scheduling state.
+         */
+        thread::state_t state;
+
+        /**
+         * @brief Thread effective priority.
+         */
+        thread::priority_t priority;
+      };
+
+      /**
+       * @brief Copy the information of all threads.
+       * @param [out] buffer Pointer to an array of thread information.
+       * @param [in] count Number of elements in the array.
+       * @param [out] total Pointer to the number of threads;
+       *  may be larger than _count_, may be nullptr.
+       * @retval result::ok The array was filled with a consistent snapshot.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval EINVAL The buffer is nullptr.
+       * @retval EAGAIN Threads were created or destroyed during the copy.
+       */
+      result_t
+      threads_snapshot (thread_info* buffer, std::size_t count,
+                        std::size_t* total = nullptr);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) */
+
     } /* namespace scheduler */
 
     // ------------------------------------------------------------------------
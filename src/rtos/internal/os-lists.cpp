@@ -47,9 +47,149 @@ namespace os
 
       // ======================================================================
 
+      /**
+       * @details
+       * Must be called in a critical section.
+       */
+      void
+      ready_threads_list::set_ready_ (waiting_thread_node& node)
+      {
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
+        if (node.thread_->state_ != thread::state::running
+            && !node.thread_->statistics_.wakeup_pending_)
+          {
+            // Remember when the thread was woken up; threads re-linked
+            // after being preempted are not accounted, and threads
+            // already stamped, for example when resumed from an
+            // interrupt and linked later, keep the original time.
+            node.thread_->statistics_.wakeup_timestamp_ = hrclock.now ();
+            node.thread_->statistics_.wakeup_pending_ = true;
+          }
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) */
+
+        node.thread_->state_ = thread::state::ready;
+      }
+
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+
+      /**
+       * @details
+       * Insert the node after all nodes with earlier or equal absolute
+       * deadlines; searching starts from the end of the list,
+       * since new deadlines are usually later than the existing ones.
+       */
+      void
+      ready_threads_list::deadline_list::link (waiting_thread_node& node)
+      {
+        if (uninitialized ())
+          {
+            // If this is the first time, initialise the list to empty.
+            clear ();
+          }
+
+        clock::timestamp_t deadline = node.thread_->absolute_deadline_;
+
+        utils::static_double_list_links* after =
+            const_cast<utils::static_double_list_links*> (tail ());
+        while (after != &head_)
+          {
+            if (static_cast<waiting_thread_node*> (after)->thread_->absolute_deadline_
+                <= deadline)
+              {
+                break;
+              }
+            after =
+                const_cast<utils::static_double_list_links*> (after->prev ());
+          }
+
+        insert_after (node, after);
+      }
+
+      /**
+       * @details
+       * Threads with a relative deadline or a period are in the
+       * EDF class. Each time such a thread is woken up, a new job
+       * is released and its absolute deadline is computed; when
+       * re-linked after being preempted or after a priority change,
+       * the thread keeps the current deadline.
+       *
+       * Must be called in a critical section.
+       */
+      bool
+      ready_threads_list::link_deadline_ (waiting_thread_node& node)
+      {
+        thread* th = node.thread_;
+
+        clock::duration_t relative =
+            (th->deadline_ != 0) ? th->deadline_ : th->period_;
+        if (relative == 0)
+          {
+            return false;
+          }
+
+        if (th->state_ != thread::state::running
+            && th->state_ != thread::state::ready)
+          {
+            th->absolute_deadline_ = sysclock.now () + relative;
+          }
+
+#if defined(OS_TRACE_RTOS_LISTS)
+        trace::printf ("ready %s() %s d%u\n", __func__, th->name (),
+                       static_cast<unsigned int> (th->absolute_deadline_));
+#endif
+
+        edf_list_.link (node);
+        set_ready_ (node);
+
+        return true;
+      }
+
+      /**
+       * @details
+       * Common to both ready list implementations.
+       *
+       * Must be called in a critical section.
+       */
+      thread*
+      ready_threads_list::unlink_deadline_head_ (void)
+      {
+        if (edf_list_.empty ())
+          {
+            return nullptr;
+          }
+
+        waiting_thread_node* node =
+            static_cast<waiting_thread_node*> (const_cast<utils::static_double_list_links *> (edf_list_.head ()));
+        thread* th = node->thread_;
+
+#if defined(OS_TRACE_RTOS_LISTS)
+        trace::printf ("ready %s() %p %s edf\n", __func__, th, th->name ());
+#endif
+
+        node->unlink ();
+
+        th->state_ = thread::state::running;
+        return th;
+      }
+
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
+      // ======================================================================
+
+#if !defined(OS_INCLUDE_RTOS_READY_LIST_PRIORITY_ARRAY)
+
       void
       ready_threads_list::link (waiting_thread_node& node)
       {
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+        if (link_deadline_ (node))
+          {
+            return;
+          }
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
         if (head_.prev () == nullptr)
           {
             // If this is the first time, initialise the list to empty.
@@ -61,7 +201,7 @@ namespace os
         waiting_thread_node* after =
             static_cast<waiting_thread_node*> (const_cast<utils::static_double_list_links *> (tail ()));
 
-        if (empty ())
+        if (static_double_list::empty ())
           {
             // Insert at the end of the list.
 #if defined(OS_TRACE_RTOS_LISTS)
@@ -76,14 +216,14 @@ namespace os
                            after->thread_->priority (), prio);
 #endif
           }
-        else if (prio > head ()->thread_->priority ())
+        else if (prio > static_cast<volatile waiting_thread_node*> (static_double_list::head ())->thread_->priority ())
           {
             // Insert at the beginning of the list.
             after =
                 static_cast<waiting_thread_node*> (const_cast<utils::static_double_list_links *> (&head_));
 #if defined(OS_TRACE_RTOS_LISTS)
             trace::printf ("ready %s() front +%u %u \n", __func__, prio,
-                           head ()->thread_->priority ());
+                           static_cast<volatile waiting_thread_node*> (static_double_list::head ())->thread_->priority ());
 #endif
           }
         else
@@ -104,7 +244,7 @@ namespace os
 
         insert_after (node, after);
 
-        node.thread_->state_ = thread::state::ready;
+        set_ready_ (node);
       }
 
       /**
@@ -116,6 +256,17 @@ namespace os
       {
         assert (!empty ());
 
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+
+        // Threads in the EDF class run before all other threads.
+        thread* edf = unlink_deadline_head_ ();
+        if (edf != nullptr)
+          {
+            return edf;
+          }
+
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
         thread* th = head ()->thread_;
 
 #if defined(OS_TRACE_RTOS_LISTS)
@@ -134,6 +285,209 @@ namespace os
         return th;
       }
 
+#else
+
+      /**
+       * @class ready_threads_list
+       * @details
+       * Instead of a single list ordered by priorities, which requires
+       * a partial list traversal for each insert, the ready threads
+       * are kept in an array of FIFO lists, one for each priority,
+       * and a two level bitmap keeps track of the non empty lists.
+       *
+       * Both inserting a node and retrieving the top priority node
+       * take constant time, the highest priority is found with two
+       * _count leading zeros_ operations, which on most architectures
+       * translate into single instructions.
+       *
+       * Nodes may also be removed from the list by directly unlinking
+       * them (for example when the thread priority changes or when the
+       * thread is killed); in this case the corresponding bit is not
+       * cleared immediately, but later, when the empty level is
+       * first encountered.
+       */
+
+      void
+      ready_threads_list::level_list::link_tail (waiting_thread_node& node)
+      {
+        if (uninitialized ())
+          {
+            // If this is the first time, initialise the list to empty.
+            clear ();
+          }
+
+        // Add node at the end of the list, to preserve the FIFO order.
+        insert_after (node,
+                      const_cast<utils::static_double_list_links*> (tail ()));
+      }
+
+      /**
+       * @details
+       * Based on priority, the node is inserted
+       * at the end of the list for that priority,
+       * and the corresponding bits are set.
+       *
+       * Must be called in a critical section.
+       */
+      void
+      ready_threads_list::link (waiting_thread_node& node)
+      {
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+        if (link_deadline_ (node))
+          {
+            return;
+          }
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
+        thread::priority_t prio = node.thread_->priority ();
+
+#if defined(OS_TRACE_RTOS_LISTS)
+        trace::printf ("ready %s() +%u\n", __func__, prio);
+#endif
+
+        lists_[prio].link_tail (node);
+
+        std::size_t group = prio / levels_per_group;
+        level_map_[group] |= (1u << (prio % levels_per_group));
+        group_map_ |= (1u << group);
+
+        set_ready_ (node);
+      }
+
+      /**
+       * @details
+       * Stale bits, left by nodes unlinked outside the list,
+       * are skipped.
+       */
+      volatile waiting_thread_node*
+      ready_threads_list::head (void) const
+      {
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+        if (!edf_list_.empty ())
+          {
+            return static_cast<volatile waiting_thread_node*> (edf_list_.head ());
+          }
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
+        uint32_t gmap = group_map_;
+        while (gmap != 0)
+          {
+            std::size_t group = levels_per_group - 1
+                - static_cast<std::size_t> (__builtin_clz (gmap));
+
+            uint32_t lmap = level_map_[group];
+            while (lmap != 0)
+              {
+                std::size_t bit = levels_per_group - 1
+                    - static_cast<std::size_t> (__builtin_clz (lmap));
+
+                const level_list& list = lists_[group * levels_per_group
+                    + bit];
+                if (!list.empty ())
+                  {
+                    return static_cast<volatile waiting_thread_node*> (list.head ());
+                  }
+                lmap &= ~(1u << bit);
+              }
+            gmap &= ~(1u << group);
+          }
+
+        return nullptr;
+      }
+
+      int
+      ready_threads_list::highest_level_ (void) const
+      {
+        if (group_map_ == 0)
+          {
+            return -1;
+          }
+
+        std::size_t group = levels_per_group - 1
+            - static_cast<std::size_t> (__builtin_clz (group_map_));
+
+        // The group bit is cleared together with the last level bit,
+        // so the level map word is never 0 here.
+        std::size_t bit = levels_per_group - 1
+            - static_cast<std::size_t> (__builtin_clz (level_map_[group]));
+
+        return static_cast<int> (group * levels_per_group + bit);
+      }
+
+      void
+      ready_threads_list::clear_level_ (std::size_t level)
+      {
+        std::size_t group = level / levels_per_group;
+        level_map_[group] &= ~(1u << (level % levels_per_group));
+        if (level_map_[group] == 0)
+          {
+            group_map_ &= ~(1u << group);
+          }
+      }
+
+      /**
+       * @details
+       * Must be called in a critical section.
+       */
+      thread*
+      ready_threads_list::unlink_head (void)
+      {
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+
+        // Threads in the EDF class run before all other threads.
+        thread* edf = unlink_deadline_head_ ();
+        if (edf != nullptr)
+          {
+            return edf;
+          }
+
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
+        int level;
+        for (;;)
+          {
+            level = highest_level_ ();
+            assert (level >= 0);
+
+            if (!lists_[level].empty ())
+              {
+                break;
+              }
+
+            // The last node was unlinked outside the list;
+            // clear the stale bit and try again.
+            clear_level_ (static_cast<std::size_t> (level));
+          }
+
+        level_list& list = lists_[level];
+        waiting_thread_node* node =
+            static_cast<waiting_thread_node*> (const_cast<utils::static_double_list_links *> (list.head ()));
+
+        thread* th = node->thread_;
+
+#if defined(OS_TRACE_RTOS_LISTS)
+        trace::printf ("ready %s() %p %s\n", __func__, th, th->name ());
+#endif
+
+        node->unlink ();
+
+        if (list.empty ())
+          {
+            clear_level_ (static_cast<std::size_t> (level));
+          }
+
+        assert (th != nullptr);
+
+        // Unlinking is immediately followed by a context switch,
+        // so in order to guarantee that the thread is marked as
+        // running, it is saver to do it here.
+
+        th->state_ = thread::state::running;
+        return th;
+      }
+
+#endif /* !defined(OS_INCLUDE_RTOS_READY_LIST_PRIORITY_ARRAY) */
+
       // ======================================================================
 
       /**
@@ -275,12 +629,66 @@ namespace os
       void
       waiting_threads_list::resume_all (void)
       {
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE)
+
+        if (!interrupts::in_handler_mode ())
+          {
+            // With the scheduler locked, the resumed threads only
+            // mark the reschedule as pending, and a single context
+            // switch is performed when the scheduler is unlocked.
+            scheduler::critical_section scs;
+
+            while (resume_one ())
+              ;
+
+            return;
+          }
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE) */
+
         while (resume_one ())
           ;
       }
 
       // ======================================================================
 
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK)
+
+      /**
+       * @details
+       * Return the value in the `[timestamp, timestamp + slack]`
+       * window with the most trailing zero bits, by clearing all bits
+       * below the most significant bit that differs between the
+       * window ends.
+       *
+       * Time stamps with overlapping windows are moved to the same
+       * aligned value, and expire in the same clock check, which
+       * reduces the number of wake-ups.
+       */
+      port::clock::timestamp_t
+      coalesced_timestamp (port::clock::timestamp_t timestamp,
+                           port::clock::duration_t slack)
+      {
+        if (slack == 0 || timestamp == 0)
+          {
+            return timestamp;
+          }
+
+        port::clock::timestamp_t low = timestamp - 1;
+        port::clock::timestamp_t high = timestamp + slack;
+
+        unsigned long long diff = static_cast<unsigned long long> (low ^ high);
+        int bit = static_cast<int> (sizeof(diff) * 8) - 1
+            - __builtin_clzll (diff);
+
+        port::clock::timestamp_t mask =
+            (static_cast<port::clock::timestamp_t> (1) << bit) - 1;
+
+        return high & ~mask;
+      }
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) */
+
       timestamp_node::timestamp_node (clock::timestamp_t ts) :
           timestamp (ts)
       {
@@ -307,6 +715,12 @@ namespace os
 #if defined(OS_TRACE_RTOS_LISTS_CONSTRUCT)
         trace::printf ("%s() %p \n", __func__, this);
 #endif
+
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK)
+        // The callers compare the current time with the requested
+        // time stamp, so the later wake-up does not alter the result.
+        timestamp = coalesced_timestamp (ts, th.slack ());
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) */
       }
 
       timeout_thread_node::~timeout_thread_node ()
@@ -364,8 +778,45 @@ namespace os
 
 #endif
 
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+
+      // ======================================================================
+
+      budget_thread_node::budget_thread_node (rtos::thread& th) :
+          timestamp_node
+            { 0 }, //
+          thread (th)
+      {
+#if defined(OS_TRACE_RTOS_LISTS_CONSTRUCT)
+        trace::printf ("%s() %p \n", __func__, this);
+#endif
+      }
+
+      budget_thread_node::~budget_thread_node ()
+      {
+#if defined(OS_TRACE_RTOS_LISTS_CONSTRUCT)
+        trace::printf ("%s() %p \n", __func__, this);
+#endif
+      }
+
+      /**
+       * @details
+       * Remove the node from the list, replenish the thread
+       * budget and resume it.
+       */
+      void
+      budget_thread_node::action (void)
+      {
+        this->unlink ();
+        thread.internal_budget_release_ ();
+      }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
       // ======================================================================
 
+#if !defined(OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL)
+
       /**
        * @details
        * The list is kept in ascending time stamp order.
@@ -434,6 +885,14 @@ namespace os
           }
 
         insert_after (node, after);
+
+#if defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE)
+        if (this == &hrclock.steady_list () && head () == &node)
+          {
+            // The new node is the earliest, maybe before the next tick.
+            hrclock.internal_program_compare ();
+          }
+#endif /* defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE) */
       }
 
       /**
@@ -480,6 +939,336 @@ namespace os
           }
       }
 
+#else
+
+      /**
+       * @class clock_timestamps_list
+       * @details
+       * Instead of a single list ordered by time stamps, which requires
+       * a partial list traversal for each insert, the nodes are kept
+       * in a hashed timing wheel, an array of unordered lists
+       * indexed by the time stamp modulo the number of slots.
+       * For clocks counting many units per tick, like `hrclock`,
+       * each slot covers `slot_units()` time units, so each tick still
+       * visits only one or two slots.
+       *
+       * Linking a node takes constant time, and unlinking it (for
+       * example when a timer is stopped or a wait ends before the
+       * timeout) is done directly on the node, as before.
+       *
+       * On each check, only the slots for the time stamps passed since
+       * the previous check are visited, and the expired nodes are
+       * collected and processed in a batch. Nodes more than
+       * a wheel revolution away remain in their slots and are
+       * skipped until they expire.
+       *
+       * A bitmap keeps track of the non empty slots; the bits of the
+       * slots emptied by unlinking nodes directly are cleared
+       * later, when the slots are visited.
+       */
+
+      void
+      clock_timestamps_list::slot_list::link_tail (
+          utils::double_list_links& node)
+      {
+        insert_after (node,
+                      const_cast<utils::static_double_list_links*> (tail ()));
+      }
+
+      /**
+       * @details
+       * The node is inserted at the end of the slot corresponding
+       * to its time stamp. Nodes with time stamps already checked
+       * are inserted in the next slot to be checked.
+       *
+       * Must be called in a critical section.
+       */
+      void
+      clock_timestamps_list::link (timestamp_node& node)
+      {
+        clock::timestamp_t period = node.timestamp / units_;
+
+        if (period < checked_)
+          {
+            period = checked_;
+          }
+
+        std::size_t slot = static_cast<std::size_t> (period % slots);
+
+#if defined(OS_TRACE_RTOS_LISTS_CLOCKS)
+        trace::printf ("clock %s() +%u [%u]\n", __func__,
+            static_cast<uint32_t> (node.timestamp),
+            static_cast<uint32_t> (slot));
+#endif
+
+        slots_[slot].link_tail (node);
+        map_ |= (1u << slot);
+      }
+
+      /**
+       * @details
+       * Must be called before linking any node; `hrclock` uses
+       * the number of cycles per tick.
+       */
+      void
+      clock_timestamps_list::slot_units (clock::timestamp_t units)
+      {
+        assert(empty ());
+        assert(units > 0);
+
+        units_ = units;
+        checked_ = 0;
+      }
+
+      /**
+       * @details
+       * Scan all non empty slots and return the node with
+       * the earliest time stamp, or `nullptr` if there are no nodes.
+       *
+       * Unlike the ordered list, this requires a full traversal,
+       * so it should not be used on critical paths.
+       */
+      volatile timestamp_node*
+      clock_timestamps_list::head (void) const
+      {
+        volatile timestamp_node* first = nullptr;
+
+        uint32_t map = map_;
+        while (map != 0)
+          {
+            std::size_t slot = static_cast<std::size_t> (__builtin_ctz (map));
+            map &= ~(1u << slot);
+
+            const slot_list& list = slots_[slot];
+            if (list.empty ())
+              {
+                continue;
+              }
+
+            const utils::static_double_list_links* last =
+                const_cast<utils::static_double_list_links*> (list.tail ());
+            utils::static_double_list_links* p =
+                const_cast<utils::static_double_list_links*> (list.head ());
+            for (;;)
+              {
+                volatile timestamp_node* node =
+                    static_cast<volatile timestamp_node*> (p);
+                if (first == nullptr || node->timestamp < first->timestamp)
+                  {
+                    first = node;
+                  }
+                if (p == last)
+                  {
+                    break;
+                  }
+                p = p->next ();
+              }
+          }
+
+        return first;
+      }
+
+      /**
+       * @details
+       * Return the start of the first period, after the ones
+       * already checked, whose slot is not empty. The slot may
+       * hold only nodes of later revolutions, so the result is
+       * not exact, but it is found in constant time, and it is
+       * enough to know how long nothing will expire.
+       */
+      clock::timestamp_t
+      clock_timestamps_list::next_timestamp (void) const
+      {
+        std::size_t first = static_cast<std::size_t> (checked_ % slots);
+
+        // Rotate the map to have the first slot to check in bit 0.
+        uint32_t map = map_;
+        if (first != 0)
+          {
+            map = (map >> first) | (map << (slots - first));
+          }
+
+        assert(map != 0);
+        clock::timestamp_t period = checked_
+            + static_cast<clock::timestamp_t> (__builtin_ctz (map));
+
+        return period * units_;
+      }
+
+      bool
+      clock_timestamps_list::empty (void) const
+      {
+        uint32_t map = map_;
+        while (map != 0)
+          {
+            std::size_t slot = static_cast<std::size_t> (__builtin_ctz (map));
+            if (!slots_[slot].empty ())
+              {
+                return false;
+              }
+            map &= ~(1u << slot);
+          }
+
+        return true;
+      }
+
+      void
+      clock_timestamps_list::collect_expired_ (std::size_t slot,
+                                               clock::timestamp_t now,
+                                               slot_list& expired)
+      {
+        slot_list& list = slots_[slot];
+
+        if (!list.empty ())
+          {
+            const utils::static_double_list_links* last =
+                const_cast<utils::static_double_list_links*> (list.tail ());
+            utils::static_double_list_links* p =
+                const_cast<utils::static_double_list_links*> (list.head ());
+            for (;;)
+              {
+                timestamp_node* node = static_cast<timestamp_node*> (p);
+                bool done = (p == last);
+                p = p->next ();
+
+                if (now >= node->timestamp)
+                  {
+                    node->unlink ();
+                    expired.link_tail (*node);
+                  }
+                if (done)
+                  {
+                    break;
+                  }
+              }
+          }
+
+        if (list.empty ())
+          {
+            map_ &= ~(1u << slot);
+          }
+      }
+
+      /**
+       * @details
+       * Nodes linked with time stamps already checked are kept in
+       * the next slot to be checked; if the clock went backwards,
+       * they are no longer due, so all nodes are moved back to
+       * the slots of their own time stamps.
+       *
+       * Must be called in a critical section.
+       */
+      void
+      clock_timestamps_list::relink_all_ (void)
+      {
+        slot_list all;
+
+        while (map_ != 0)
+          {
+            std::size_t slot = static_cast<std::size_t> (__builtin_ctz (map_));
+            map_ &= ~(1u << slot);
+
+            slot_list& list = slots_[slot];
+            while (!list.empty ())
+              {
+                timestamp_node* node =
+                    static_cast<timestamp_node*> (const_cast<utils::static_double_list_links*> (list.head ()));
+                node->unlink ();
+                all.link_tail (*node);
+              }
+          }
+
+        while (!all.empty ())
+          {
+            timestamp_node* node =
+                static_cast<timestamp_node*> (const_cast<utils::static_double_list_links*> (all.head ()));
+            node->unlink ();
+            link (*node);
+          }
+      }
+
+      /**
+       * @details
+       * Visit the slots for the time stamps passed since the
+       * previous check (or all slots, if more than a revolution passed),
+       * move the nodes with reached time stamps to a separate list,
+       * and run their actions in this order.
+       *
+       * A slot is checked again as long as its period did not
+       * pass completely, since it may still hold later time stamps.
+       *
+       * The action must unlink the node; periodic timers
+       * are re-linked with new time stamps in later slots.
+       */
+      void
+      clock_timestamps_list::check_timestamp (clock::timestamp_t now)
+      {
+        if (slots_[0].uninitialized ())
+          {
+            // This happens before the constructors are executed.
+            return;
+          }
+
+        slot_list expired;
+
+          {
+            // ----- Enter critical section -----------------------------------
+            interrupts::critical_section ics;
+
+            // The periods up to `last` are visited; those before
+            // `done` passed completely.
+            clock::timestamp_t last = now / units_;
+            clock::timestamp_t done = (now + 1) / units_;
+
+            if (done < checked_)
+              {
+                // Adjusted clocks may go backwards.
+                checked_ = done;
+                relink_all_ ();
+              }
+
+            clock::timestamp_t first = checked_;
+            if (last + 1 - first > slots)
+              {
+                // More than a revolution passed, visit all slots,
+                // starting with the oldest.
+                first = last + 1 - slots;
+              }
+
+            for (clock::timestamp_t period = first; period <= last; ++period)
+              {
+                std::size_t slot = static_cast<std::size_t> (period % slots);
+                if ((map_ & (1u << slot)) != 0)
+                  {
+                    collect_expired_ (slot, now, expired);
+                  }
+              }
+
+            checked_ = done;
+            // ----- Exit critical section ------------------------------------
+          }
+
+        for (;;)
+          {
+            // ----- Enter critical section -----------------------------------
+            interrupts::critical_section ics;
+
+            if (expired.empty ())
+              {
+                break;
+              }
+
+#if defined(OS_TRACE_RTOS_LISTS_CLOCKS)
+            trace::printf ("%s() %u \n", __func__,
+                static_cast<uint32_t> (sysclock.now ()));
+#endif
+            const_cast<timestamp_node*> (static_cast<volatile timestamp_node*> (expired.head ()))->action ();
+            // ----- Exit critical section ------------------------------------
+          }
+      }
+
+#endif /* !defined(OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL) */
+
       // ======================================================================
 
       void
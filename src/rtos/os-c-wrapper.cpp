@@ -226,7 +226,8 @@ static_assert(sizeof(class thread::stack) == sizeof(os_thread_stack_t), "adjust
 static_assert(sizeof(class thread::context) == sizeof(os_thread_context_t), "adjust size of os_thread_context_t");
 
 #if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
-  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
+  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) \
+  || defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
 static_assert(sizeof(class thread::statistics) == sizeof(os_thread_statistics_t), "adjust size of os_thread_statistics_t");
 #endif
 
@@ -401,6 +402,43 @@ os_sched_stat_get_cpu_cycles (void)
 
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) \
+  && !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+/**
+ * @details
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::scheduler::statistics::idle_cpu_load()
+ */
+uint16_t
+os_sched_stat_get_idle_cpu_load (size_t windows)
+{
+  return scheduler::statistics::idle_cpu_load (windows);
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) && !defined(OS_USE_RTOS_PORT_SCHEDULER) */
+
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+/**
+ * @details
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::scheduler::statistics::quantum_expirations()
+ */
+os_statistics_counter_t
+os_sched_stat_get_quantum_expirations (void)
+{
+  return static_cast<os_statistics_counter_t> (scheduler::statistics::quantum_expirations ());
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
 // ----------------------------------------------------------------------------
 
 /**
@@ -768,6 +806,247 @@ os_thread_set_priority (os_thread_t* thread, os_thread_prio_t prio)
       prio);
 }
 
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+/**
+ * @details
+ *
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::quantum()
+ */
+os_clock_duration_t
+os_thread_get_quantum (os_thread_t* thread)
+{
+  assert (thread != nullptr);
+  return (os_clock_duration_t) (reinterpret_cast<rtos::thread&> (*thread)).quantum ();
+}
+
+/**
+ * @details
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::quantum(clock::duration_t)
+ */
+os_result_t
+os_thread_set_quantum (os_thread_t* thread, os_clock_duration_t ticks)
+{
+  assert (thread != nullptr);
+  return (os_result_t) (reinterpret_cast<rtos::thread&> (*thread)).quantum (
+      ticks);
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+
+/**
+ * @details
+ *
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::deadline()
+ */
+os_clock_duration_t
+os_thread_get_deadline (os_thread_t* thread)
+{
+  assert (thread != nullptr);
+  return (os_clock_duration_t) (reinterpret_cast<rtos::thread&> (*thread)).deadline ();
+}
+
+/**
+ * @details
+ *
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::period()
+ */
+os_clock_duration_t
+os_thread_get_period (os_thread_t* thread)
+{
+  assert (thread != nullptr);
+  return (os_clock_duration_t) (reinterpret_cast<rtos::thread&> (*thread)).period ();
+}
+
+/**
+ * @details
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::deadline(clock::duration_t, clock::duration_t)
+ */
+os_result_t
+os_thread_set_deadline (os_thread_t* thread, os_clock_duration_t ticks,
+                        os_clock_duration_t period)
+{
+  assert (thread != nullptr);
+  return (os_result_t) (reinterpret_cast<rtos::thread&> (*thread)).deadline (
+      ticks, period);
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+/**
+ * @details
+ *
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::affinity()
+ */
+os_thread_affinity_t
+os_thread_get_affinity (os_thread_t* thread)
+{
+  assert (thread != nullptr);
+  return (os_thread_affinity_t) (reinterpret_cast<rtos::thread&> (*thread)).affinity ();
+}
+
+/**
+ * @details
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::affinity(affinity_t)
+ */
+os_result_t
+os_thread_set_affinity (os_thread_t* thread, os_thread_affinity_t mask)
+{
+  assert (thread != nullptr);
+  return (os_result_t) (reinterpret_cast<rtos::thread&> (*thread)).affinity (
+      mask);
+}
+
+/**
+ * @details
+ *
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::core()
+ */
+size_t
+os_thread_get_core (os_thread_t* thread)
+{
+  assert (thread != nullptr);
+  return (reinterpret_cast<rtos::thread&> (*thread)).core ();
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+
+/**
+ * @details
+ *
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::budget()
+ */
+os_statistics_duration_t
+os_thread_get_budget (os_thread_t* thread)
+{
+  assert (thread != nullptr);
+  return (os_statistics_duration_t) (reinterpret_cast<rtos::thread&> (*thread)).budget ();
+}
+
+/**
+ * @details
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::budget(rtos::statistics::duration_t, clock::duration_t)
+ */
+os_result_t
+os_thread_set_budget (os_thread_t* thread, os_statistics_duration_t cycles,
+                      os_clock_duration_t period_ticks)
+{
+  assert (thread != nullptr);
+  return (os_result_t) (reinterpret_cast<rtos::thread&> (*thread)).budget (
+      cycles, period_ticks);
+}
+
+/**
+ * @details
+ *
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::throttled()
+ */
+bool
+os_thread_is_throttled (os_thread_t* thread)
+{
+  assert (thread != nullptr);
+  return (reinterpret_cast<rtos::thread&> (*thread)).throttled ();
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT)
+
+/**
+ * @details
+ *
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::fpu_used()
+ */
+bool
+os_thread_is_fpu_used (os_thread_t* thread)
+{
+  assert (thread != nullptr);
+  return (reinterpret_cast<rtos::thread&> (*thread)).fpu_used ();
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) */
+
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK)
+
+/**
+ * @details
+ *
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::slack()
+ */
+os_clock_duration_t
+os_thread_get_slack (os_thread_t* thread)
+{
+  assert (thread != nullptr);
+  return (os_clock_duration_t) (reinterpret_cast<rtos::thread&> (*thread)).slack ();
+}
+
+/**
+ * @details
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::slack(clock::duration_t)
+ */
+os_result_t
+os_thread_set_slack (os_thread_t* thread, os_clock_duration_t slack)
+{
+  assert (thread != nullptr);
+  return (os_result_t) (reinterpret_cast<rtos::thread&> (*thread)).slack (
+      slack);
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) */
+
 /**
  * @details
  *
@@ -783,6 +1062,21 @@ os_thread_join (os_thread_t* thread, void** exit_ptr)
   return (os_result_t) reinterpret_cast<rtos::thread&> (*thread).join (exit_ptr);
 }
 
+/**
+ * @details
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::join_all()
+ */
+os_result_t
+os_thread_join_all (os_thread_t* threads[], size_t count, void** exit_ptrs)
+{
+  return (os_result_t) rtos::thread::join_all (
+      reinterpret_cast<rtos::thread**> (threads), count, exit_ptrs);
+}
+
 /**
  * @details
  *
@@ -853,6 +1147,71 @@ os_thread_get_user_storage (os_thread_t* thread)
 
 #endif /* defined(OS_INCLUDE_RTOS_CUSTOM_THREAD_USER_STORAGE) */
 
+#if defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC)
+
+/**
+ * @details
+ *
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::specific(specific_key_t)
+ */
+void*
+os_thread_get_specific (os_thread_t* thread, os_thread_specific_key_t key)
+{
+  assert (thread != nullptr);
+  return (reinterpret_cast<rtos::thread&> (*thread)).specific (key);
+}
+
+/**
+ * @details
+ *
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::specific(specific_key_t, void*)
+ */
+os_result_t
+os_thread_set_specific (os_thread_t* thread, os_thread_specific_key_t key,
+                        void* value)
+{
+  assert (thread != nullptr);
+  return (os_result_t) (reinterpret_cast<rtos::thread&> (*thread)).specific (
+      key, value);
+}
+
+/**
+ * @details
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::specific_key_create()
+ */
+os_result_t
+os_thread_specific_key_create (os_thread_specific_key_t* key,
+                               os_thread_specific_destructor_t destructor)
+{
+  return (os_result_t) thread::specific_key_create (key, destructor);
+}
+
+/**
+ * @details
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::specific_key_delete()
+ */
+os_result_t
+os_thread_specific_key_delete (os_thread_specific_key_t key)
+{
+  return (os_result_t) thread::specific_key_delete (key);
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC) */
+
 /**
  * @details
  *
@@ -986,6 +1345,39 @@ os_thread_stack_get_available (os_thread_stack_t* stack)
   return (reinterpret_cast<class rtos::thread::stack&> (*stack)).available ();
 }
 
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+
+/**
+ * @details
+ *
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::stack::high_water_mark()
+ */
+size_t
+os_thread_stack_get_high_water_mark (os_thread_stack_t* stack)
+{
+  assert (stack != nullptr);
+  return (reinterpret_cast<class rtos::thread::stack&> (*stack)).high_water_mark ();
+}
+
+/**
+ * @details
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::stack::report()
+ */
+void
+os_thread_stack_report (void)
+{
+  thread::stack::report ();
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
+
 /**
  * @details
  *
@@ -1056,6 +1448,59 @@ os_thread_stat_get_cpu_cycles (os_thread_t* thread)
 
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+/**
+ * @details
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::statistics::cpu_load()
+ */
+uint16_t
+os_thread_stat_get_cpu_load (os_thread_t* thread, size_t windows)
+{
+  assert (thread != nullptr);
+  return (reinterpret_cast<rtos::thread&> (*thread)).statistics ().cpu_load (windows);
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
+/**
+ * @details
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::statistics::wakeup_latency()
+ */
+os_statistics_counter_t
+os_thread_stat_get_wakeup_latency (os_thread_t* thread, size_t bucket)
+{
+  assert (thread != nullptr);
+  return static_cast<os_statistics_counter_t> ((reinterpret_cast<rtos::thread&> (*thread)).statistics ().wakeup_latency (bucket));
+}
+
+/**
+ * @details
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::thread::statistics::wakeup_latency_max()
+ */
+os_statistics_duration_t
+os_thread_stat_get_wakeup_latency_max (os_thread_t* thread)
+{
+  assert (thread != nullptr);
+  return static_cast<os_statistics_duration_t> ((reinterpret_cast<rtos::thread&> (*thread)).statistics ().wakeup_latency_max ());
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) */
+
 // ----------------------------------------------------------------------------
 
 /**
@@ -1203,6 +1648,27 @@ os_clock_sleep_until (os_clock_t* clock, os_clock_timestamp_t timestamp)
       timestamp);
 }
 
+#if defined(OS_INCLUDE_RTOS_THREAD_PERIODIC_SLEEP)
+
+/**
+ * @details
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::clock::sleep_until_next_period()
+ */
+os_result_t
+os_clock_sleep_until_next_period (os_clock_t* clock, os_clock_duration_t period,
+                                  size_t* overruns)
+{
+  assert (clock != nullptr);
+  return (os_result_t) (reinterpret_cast<rtos::clock&> (*clock)).sleep_until_next_period (
+      period, overruns);
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_PERIODIC_SLEEP) */
+
 /**
  * @details
  *
@@ -1534,6 +2000,25 @@ os_timer_stop (os_timer_t* timer)
   return (os_result_t) (reinterpret_cast<rtos::timer&> (*timer)).stop ();
 }
 
+#if defined(OS_INCLUDE_RTOS_TIMER_DAEMON)
+
+/**
+ * @details
+ *
+ * @note Can be invoked from Interrupt Service Routines.
+ *
+ * @par For the complete definition, see
+ *  @ref os::rtos::timer::overruns()
+ */
+size_t
+os_timer_get_overruns (os_timer_t* timer)
+{
+  assert (timer != nullptr);
+  return (reinterpret_cast<rtos::timer&> (*timer)).overruns ();
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_TIMER_DAEMON) */
+
 // ----------------------------------------------------------------------------
 
 /**
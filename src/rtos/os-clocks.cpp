@@ -27,6 +27,8 @@
 
 #include <cmsis-plus/rtos/os.h>
 
+#include <limits>
+
 // ----------------------------------------------------------------------------
 
 using namespace os;
@@ -34,6 +36,13 @@ using namespace os::rtos;
 
 // ----------------------------------------------------------------------------
 
+#if !defined(OS_INCLUDE_RTOS_REALTIME_CLOCK_DRIVER)
+
+// Count down SysTick ticks to simulate an RTC driver.
+static uint32_t os_rtc_simulated_ticks = clock_systick::frequency_hz;
+
+#endif /* !defined(OS_INCLUDE_RTOS_REALTIME_CLOCK_DRIVER) */
+
 /**
  * @details
  * Must be called from the physical interrupt handler.
@@ -66,14 +75,54 @@ os_systick_handler (void)
   sysclock.internal_check_timestamps ();
   hrclock.internal_check_timestamps ();
 
+#if defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE)
+
+  // Time stamps due before the next tick need a compare match.
+  hrclock.internal_program_compare ();
+
+#endif /* defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE) */
+
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN) \
+  && !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+  bool quantum_expired;
+    {
+      // ----- Enter critical section -----------------------------------------
+      interrupts::critical_section ics;
+
+      quantum_expired = scheduler::internal_check_quantum ();
+      // ----- Exit critical section ------------------------------------------
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) \
+  && !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+  bool budget_used;
+    {
+      // ----- Enter critical section -----------------------------------------
+      interrupts::critical_section ics;
+
+      budget_used = scheduler::internal_check_budget ();
+      // ----- Exit critical section ------------------------------------------
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) \
+  && !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+  scheduler::internal_check_cpu_load ();
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) */
+
 #if !defined(OS_INCLUDE_RTOS_REALTIME_CLOCK_DRIVER)
 
   // Simulate an RTC driver.
-  static uint32_t ticks = clock_systick::frequency_hz;
-
-  if (--ticks == 0)
+  if (--os_rtc_simulated_ticks == 0)
     {
-      ticks = clock_systick::frequency_hz;
+      os_rtc_simulated_ticks = clock_systick::frequency_hz;
 
       os_rtc_handler ();
     }
@@ -82,7 +131,33 @@ os_systick_handler (void)
 
 #if !defined(OS_USE_RTOS_PORT_SCHEDULER)
 
-  port::scheduler::reschedule ();
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+  // Threads resumed by the expired timestamps already requested
+  // a context switch; here only rotate the running thread,
+  // if it used its entire time slice.
+  if (quantum_expired)
+    {
+      scheduler::internal_reschedule ();
+    }
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+  // The running thread used its CPU budget, throttle it.
+  else if (budget_used)
+    {
+      scheduler::internal_reschedule ();
+    }
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
+#else
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+  // Rescheduled anyway, the budget check only replenishes.
+  (void) budget_used;
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
+  scheduler::internal_reschedule ();
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
 
 #endif /* !defined(OS_USE_RTOS_PORT_SCHEDULER) */
 
@@ -91,6 +166,29 @@ os_systick_handler (void)
 #endif
 }
 
+#if defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE)
+
+/**
+ * @details
+ * Must be called from the physical interrupt handler of the
+ * compare match programmed by `port::clock_highres::arm_compare()`.
+ */
+void
+os_hrclock_compare_handler (void)
+{
+  using namespace os::rtos;
+
+  hrclock.internal_check_compare ();
+
+#if !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+  scheduler::internal_reschedule ();
+
+#endif /* !defined(OS_USE_RTOS_PORT_SCHEDULER) */
+}
+
+#endif /* defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE) */
+
 /**
  * @details
  * Must be called from the physical RTC interrupt handler.
@@ -168,12 +266,30 @@ namespace os
     clock::timestamp_t
     clock::now (void)
     {
+#if defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK)
+
+      // Retry if the tick interrupt changed the count during the read.
+      timestamp_t ts;
+      uint32_t seq;
+      do
+        {
+          seq = internal_read_begin_ ();
+          ts = steady_count_;
+        }
+      while (internal_read_retry_ (seq));
+
+      return ts;
+
+#else
+
       // ----- Enter critical section -----------------------------------------
       interrupts::critical_section ics;
 
       // Prevent inconsistent values using the critical section.
       return steady_count_;
       // ----- Exit critical section ------------------------------------------
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK) */
     }
 
     /**
@@ -184,12 +300,29 @@ namespace os
     clock::timestamp_t
     clock::steady_now (void)
     {
+#if defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK)
+
+      timestamp_t ts;
+      uint32_t seq;
+      do
+        {
+          seq = internal_read_begin_ ();
+          ts = steady_count_;
+        }
+      while (internal_read_retry_ (seq));
+
+      return ts;
+
+#else
+
       // ----- Enter critical section -----------------------------------------
       interrupts::critical_section ics;
 
       // Prevent inconsistent values using the critical section.
       return steady_count_;
       // ----- Exit critical section ------------------------------------------
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK) */
     }
 
     /**
@@ -273,6 +406,85 @@ namespace os
       return ENOTRECOVERABLE;
     }
 
+#if defined(OS_INCLUDE_RTOS_THREAD_PERIODIC_SLEEP)
+
+    /**
+     * @details
+     * Each thread keeps the steady timestamp of its next release;
+     * the first call anchors it to the current time. Each call
+     * advances it by exactly one _period_ and sleeps until then,
+     * so the duration of the loop body and the
+     * wake-up latency do not accumulate drift.
+     *
+     * If the release was already missed, the missed periods are
+     * skipped, the next release in the future is used, and the
+     * number of skipped releases is returned in _overruns_.
+     *
+     * A thread should use the same clock and period for all calls.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    clock::sleep_until_next_period (duration_t period, std::size_t* overruns)
+    {
+#if defined(OS_TRACE_RTOS_CLOCKS)
+      trace::printf ("%s(%u) %p %s\n", __func__,
+                     static_cast<unsigned int> (period),
+                     &this_thread::thread (), this_thread::thread ().name ());
+#endif
+
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      os_assert_err(!scheduler::locked (), EPERM);
+      os_assert_err(period > 0, EINVAL);
+
+      thread& crt = this_thread::thread ();
+      timestamp_t n = steady_now ();
+
+      if (crt.next_release_ == 0)
+        {
+          crt.next_release_ = n;
+        }
+      crt.next_release_ += period;
+
+      std::size_t missed = 0;
+      if (crt.next_release_ <= n)
+        {
+          missed = static_cast<std::size_t> ((n - crt.next_release_) / period)
+              + 1;
+          crt.next_release_ += missed * period;
+        }
+
+      if (overruns != nullptr)
+        {
+          *overruns = missed;
+        }
+
+      timestamp_t timestamp = crt.next_release_;
+      for (;;)
+        {
+          result_t res;
+          res = internal_wait_until_ (timestamp, steady_list_);
+
+          if (steady_now () >= timestamp)
+            {
+              return ETIMEDOUT;
+            }
+
+          if (crt.interrupted ())
+            {
+              return EINTR;
+            }
+
+          if (res != result::ok)
+            {
+              return res;
+            }
+        }
+      return ENOTRECOVERABLE;
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_PERIODIC_SLEEP) */
+
     /**
      * @details
      *
@@ -324,7 +536,9 @@ namespace os
       // ----- Enter critical section -----------------------------------------
       interrupts::critical_section ics;
 
+      internal_begin_update_ ();
       steady_count_ += duration;
+      internal_end_update_ ();
 
       internal_check_timestamps ();
       return steady_count_;
@@ -412,6 +626,25 @@ namespace os
     clock::timestamp_t
     adjustable_clock::now (void)
     {
+#if defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK)
+
+      // The offset is updated with the same sequence as the count.
+      timestamp_t ts;
+      uint32_t seq;
+      do
+        {
+          seq = internal_read_begin_ ();
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+          ts = steady_count_ + offset_;
+#pragma GCC diagnostic pop
+        }
+      while (internal_read_retry_ (seq));
+
+      return ts;
+
+#else
+
       // Prevent inconsistent values.
       // ----- Enter critical section -----------------------------------------
       interrupts::critical_section ics;
@@ -421,6 +654,8 @@ namespace os
       return steady_count_ + offset_;
 #pragma GCC diagnostic pop
       // ----- Exit critical section ------------------------------------------
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK) */
     }
 
     /**
@@ -486,7 +721,9 @@ namespace os
 
       offset_t tmp;
       tmp = offset_;
+      internal_begin_update_ ();
       offset_ = value;
+      internal_end_update_ ();
 
       return tmp;
       // ----- Exit critical section ------------------------------------------
@@ -603,6 +840,130 @@ namespace os
 
 #endif /* defined(OS_USE_RTOS_PORT_CLOCK_SYSTICK_WAIT_FOR) */
 
+#if defined(OS_INCLUDE_RTOS_TICKLESS_IDLE)
+
+    /**
+     * @details
+     * Compute the number of ticks up to the earliest timestamp
+     * in the SysTick and high resolution clock lists (with the
+     * timing wheel, up to the first non empty slot), and ask
+     * the port to suppress the ticks and sleep for at most
+     * this duration.
+     *
+     * On wake up, the clocks are advanced with the number
+     * of ticks elapsed, and the expired timestamps are
+     * processed, as if the ticks were not suppressed.
+     *
+     * Without an RTC driver, the simulated RTC limits the
+     * duration to the end of the current second.
+     *
+     * @note Called from the idle thread.
+     */
+    bool
+    clock_systick::internal_tickless_sleep (void)
+    {
+      duration_t slept;
+
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          timestamp_t ticks = std::numeric_limits<duration_t>::max ();
+
+          if (!steady_list_.empty ())
+            {
+              timestamp_t ts = steady_list_.next_timestamp ();
+              ticks = (ts > steady_count_) ? (ts - steady_count_) : 0;
+            }
+
+          if (!hrclock.steady_list ().empty ())
+            {
+              timestamp_t ts = hrclock.steady_list ().next_timestamp ();
+              timestamp_t nw = hrclock.now ();
+              timestamp_t hrticks =
+                  (ts > nw) ?
+                      ((ts - nw) / port::clock_highres::cycles_per_tick ()) :
+                      0;
+              if (hrticks < ticks)
+                {
+                  ticks = hrticks;
+                }
+            }
+
+#if !defined(OS_INCLUDE_RTOS_REALTIME_CLOCK_DRIVER)
+
+          if (os_rtc_simulated_ticks < ticks)
+            {
+              ticks = os_rtc_simulated_ticks;
+            }
+
+#endif /* !defined(OS_INCLUDE_RTOS_REALTIME_CLOCK_DRIVER) */
+
+          if (ticks < 2)
+            {
+              // Not worth suppressing a single tick.
+              return false;
+            }
+
+#if defined(OS_TRACE_RTOS_SYSCLOCK_TICK)
+          trace::printf ("{%u", static_cast<unsigned int> (ticks));
+#endif
+
+          slept = port::clock_systick::suppress_ticks_and_sleep (
+              static_cast<duration_t> (ticks));
+
+          // Catch up with the ticks elapsed while sleeping.
+          internal_begin_update_ ();
+          steady_count_ += slept;
+          internal_end_update_ ();
+          hrclock.internal_increment_count (slept);
+
+#if !defined(OS_INCLUDE_RTOS_REALTIME_CLOCK_DRIVER)
+
+          os_rtc_simulated_ticks -= slept;
+
+#endif /* !defined(OS_INCLUDE_RTOS_REALTIME_CLOCK_DRIVER) */
+
+          // ----- Exit critical section --------------------------------------
+        }
+
+#if defined(OS_TRACE_RTOS_SYSCLOCK_TICK)
+      trace::printf ("%u}", static_cast<unsigned int> (slept));
+#endif
+
+      internal_check_timestamps ();
+      hrclock.internal_check_timestamps ();
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) \
+  && !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+      // A long sleep is accounted in a single, longer, window.
+      scheduler::internal_check_cpu_load ();
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) */
+
+#if !defined(OS_INCLUDE_RTOS_REALTIME_CLOCK_DRIVER)
+
+      if (os_rtc_simulated_ticks == 0)
+        {
+          os_rtc_simulated_ticks = frequency_hz;
+
+          os_rtc_handler ();
+        }
+
+#endif /* !defined(OS_INCLUDE_RTOS_REALTIME_CLOCK_DRIVER) */
+
+#if !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+      scheduler::internal_reschedule ();
+
+#endif /* !defined(OS_USE_RTOS_PORT_SCHEDULER) */
+
+      return true;
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_TICKLESS_IDLE) */
+
     // ========================================================================
 
     /**
@@ -744,19 +1105,110 @@ namespace os
       trace::printf ("clock_highres::%s()\n", __func__);
 #endif
 
+#if defined(OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL)
+
+      // The time stamps are in cycles, but are checked on ticks.
+      steady_list_.slot_units (port::clock_highres::cycles_per_tick ());
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL) */
+
       port::clock_highres::start ();
     }
 
     clock::timestamp_t
     clock_highres::now (void)
     {
+#if defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK)
+
+      // A tick between the two reads changes the sequence,
+      // so the count and the cycles always belong to the same tick.
+      timestamp_t ts;
+      uint32_t seq;
+      do
+        {
+          seq = internal_read_begin_ ();
+          ts = steady_count_ + port::clock_highres::cycles_since_tick ();
+        }
+      while (internal_read_retry_ (seq));
+
+      return ts;
+
+#else
+
       // ----- Enter critical section -----------------------------------------
       interrupts::critical_section ics;
 
       return steady_count_ + port::clock_highres::cycles_since_tick ();
       // ----- Exit critical section ------------------------------------------
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK) */
     }
 
+#if defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE)
+
+    /**
+     * @details
+     * The high resolution waits may end between ticks, and the
+     * callers compare the steady time with the requested time stamp,
+     * so the steady time includes the cycles since the last tick.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    clock::timestamp_t
+    clock_highres::steady_now (void)
+    {
+      return clock_highres::now ();
+    }
+
+    /**
+     * @details
+     * If the earliest time stamp is due before the next tick,
+     * ask the port to program a compare match for it; later time
+     * stamps are handled by the tick, which calls this function
+     * again. Called when a node is linked to the list, on each tick
+     * and after each compare match.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    void
+    clock_highres::internal_program_compare (void)
+    {
+      // ----- Enter critical section -----------------------------------------
+      interrupts::critical_section ics;
+
+      if (steady_list_.empty ())
+        {
+          return;
+        }
+
+      timestamp_t ts = steady_list_.head ()->timestamp;
+      if (ts >= steady_count_ + port::clock_highres::cycles_per_tick ())
+        {
+          return;
+        }
+
+      timestamp_t nw = now ();
+      port::clock_highres::arm_compare (
+          (ts > nw) ? static_cast<duration_t> (ts - nw) : 1);
+      // ----- Exit critical section ------------------------------------------
+    }
+
+    /**
+     * @details
+     * Called from `os_hrclock_compare_handler()`; process the
+     * time stamps expired up to the current cycle, not only
+     * up to the last tick, and program the next compare match.
+     */
+    void
+    clock_highres::internal_check_compare (void)
+    {
+      steady_list_.check_timestamp (now ());
+
+      internal_program_compare ();
+    }
+
+#endif /* defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE) */
+
   // --------------------------------------------------------------------------
 
   } /* namespace rtos */
@@ -27,8 +27,19 @@
 
 #include <cmsis-plus/rtos/os.h>
 
+#include <cstdlib>
+#include <cstring>
+
 // ----------------------------------------------------------------------------
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) \
+  && !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+// Defined in os-idle.cpp.
+extern os::rtos::thread* os_idle_thread;
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) */
+
 namespace
 {
 #if defined(OS_HAS_INTERRUPTS_STACK)
@@ -67,6 +78,17 @@ namespace os
        */
       bool is_started_ = false;
 
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE)
+
+      /**
+       * @details
+       * Set when a context switch was requested while the scheduler
+       * was locked; cleared when the scheduler is unlocked.
+       */
+      bool volatile is_reschedule_pending_ = false;
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE) */
+
 #if 0
       /**
        * @details
@@ -96,6 +118,20 @@ namespace os
 
       bool is_preemptive_ = false;
 
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+      thread* volatile current_threads_[OS_INTEGER_RTOS_SCHEDULER_CORES];
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wglobal-constructors"
+#pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+      internal::ready_threads_list ready_threads_lists_[OS_INTEGER_RTOS_SCHEDULER_CORES];
+#pragma GCC diagnostic pop
+
+#else
+
       thread* volatile current_thread_;
 
 #pragma GCC diagnostic push
@@ -105,6 +141,34 @@ namespace os
 #endif
       internal::ready_threads_list ready_threads_list_;
 #pragma GCC diagnostic pop
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME)
+
+      /**
+       * @details
+       * Lock free list of threads resumed from interrupts, but
+       * not yet linked to the ready list. It is a single linked
+       * LIFO, using the thread `deferred_next_` member.
+       */
+      thread* deferred_threads_;
+
+#endif /* defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wglobal-constructors"
+#pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+      // Threads that used their CPU budget, until replenished.
+      internal::waiting_threads_list throttled_threads_list_;
+#pragma GCC diagnostic pop
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
 #endif
 
 #pragma GCC diagnostic push
@@ -115,6 +179,13 @@ namespace os
       internal::terminated_threads_list terminated_threads_list_;
 #pragma GCC diagnostic pop
 
+#if defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) \
+  || defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+
+      uint32_t threads_generation_;
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) || defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
+
       /**
        * @endcond
        */
@@ -180,6 +251,21 @@ namespace os
 
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+        scheduler::statistics::cpu_load_epoch_ = 0;
+        scheduler::statistics::cpu_load_ticks_ = sysclock.now ();
+        scheduler::statistics::cpu_load_timestamp_ =
+            scheduler::statistics::switch_timestamp_;
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) */
+
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+        scheduler::statistics::quantum_expirations_ = 0;
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
 #if !defined(OS_USE_RTOS_PORT_SCHEDULER)
         is_preemptive_ = OS_BOOL_RTOS_SCHEDULER_PREEMPTIVE;
 #endif /* defined(OS_USE_RTOS_PORT_SCHEDULER) */
@@ -222,6 +308,89 @@ namespace os
 #endif
       }
 
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE)
+
+      /**
+       * @details
+       * Called after the scheduler lock state was changed; if the
+       * scheduler is no longer locked and threads were resumed
+       * meanwhile, perform the context switch postponed by
+       * `internal_reschedule()`.
+       *
+       * The flag is atomically exchanged, so a request from an
+       * interrupt is never lost, at most it triggers an extra
+       * reschedule. On ARMv6-M, which has no exclusive access
+       * instructions, a critical section is used instead.
+       */
+      void
+      internal_reschedule_pending (void)
+      {
+        if (locked ())
+          {
+            return;
+          }
+
+        bool pending;
+
+#if defined(__ARM_ARCH_6M__)
+
+          {
+            // ----- Enter critical section -------------------------------
+            interrupts::critical_section ics;
+
+            pending = is_reschedule_pending_;
+            is_reschedule_pending_ = false;
+            // ----- Exit critical section --------------------------------
+          }
+
+#else
+
+        pending = __atomic_exchange_n (&is_reschedule_pending_, false,
+                                       __ATOMIC_SEQ_CST);
+
+#endif /* defined(__ARM_ARCH_6M__) */
+
+        if (pending)
+          {
+            port::scheduler::reschedule ();
+          }
+      }
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE) */
+
+      /**
+       * @details
+       * Destroy the threads in the terminated list; yield after
+       * each one, since deallocating stacks may take some time.
+       *
+       * Called by the idle thread and, if enabled, by the reaper thread;
+       * since both may run it, the list is checked again inside the
+       * critical section, before taking its head.
+       */
+      void
+      internal_destroy_terminated (void)
+      {
+        while (!terminated_threads_list_.empty ())
+          {
+            internal::waiting_thread_node* node;
+              {
+                // ----- Enter critical section ---------------------------
+                interrupts::critical_section ics;
+                if (terminated_threads_list_.empty ())
+                  {
+                    break;
+                  }
+                node =
+                    const_cast<internal::waiting_thread_node*> (terminated_threads_list_.head ());
+                node->unlink ();
+                // ----- Exit critical section ----------------------------
+              }
+            node->thread_->internal_destroy_ ();
+
+            this_thread::yield ();
+          }
+      }
+
       /**
        * @details
        * If the input pointer is nullptr, the function returns the
@@ -240,6 +409,172 @@ namespace os
           }
       }
 
+#if defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) \
+  || defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+
+      /**
+       * @cond ignore
+       */
+
+      /**
+       * @details
+       * Return the thread following the given one in a depth first
+       * walk of the threads tree, in the same order as
+       * `children_threads()`, or nullptr after the last thread;
+       * if the input pointer is nullptr, return the first thread.
+       *
+       * Must be called with the scheduler locked.
+       */
+      thread*
+      internal_next_thread (thread* th)
+      {
+        thread::threads_list& children = children_threads (th);
+        if (!children.empty ())
+          {
+            return &(*children.begin ());
+          }
+
+        while (th != nullptr)
+          {
+            thread::threads_list& siblings = children_threads (th->parent_);
+            thread::threads_list::iterator it
+              {
+                  static_cast<utils::double_list_links*> (th->child_links_.next ()) };
+            if (it != siblings.end ())
+              {
+                return &(*it);
+              }
+            th = th->parent_;
+          }
+
+        return nullptr;
+      }
+
+      /**
+       * @endcond
+       */
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) || defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT)
+
+      /**
+       * @cond ignore
+       */
+
+      namespace
+      {
+        void
+        snapshot_thread (thread& th, thread_info& info)
+        {
+          class thread::stack& st = th.stack ();
+
+          // The thread may be destroyed before the caller uses
+          // the information, so nothing refers to it.
+          std::strncpy (info.name, th.name (), sizeof(info.name) - 1);
+          info.name[sizeof(info.name) - 1] = '\0';
+          info.stack_size_bytes = st.size ();
+          if (st.size () > 0)
+            {
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+              info.stack_used_bytes = st.high_water_mark ();
+#else
+              info.stack_used_bytes = st.size () - st.available ();
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
+            }
+          else
+            {
+              info.stack_used_bytes = 0;
+            }
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
+          info.cpu_cycles = th.statistics ().cpu_cycles ();
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES)
+          info.context_switches = th.statistics ().context_switches ();
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) */
+          info.state = th.state ();
+          info.priority = th.priority ();
+        }
+      } /* namespace */
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @details
+       * Walk the tree of threads, in the same order as
+       * `children_threads()`, and copy the information of
+       * the first _count_ threads into the caller buffer.
+       *
+       * To avoid keeping the scheduler locked for the entire walk,
+       * which may be long, since it includes scanning the stacks,
+       * the threads are copied in chunks of
+       * `OS_INTEGER_RTOS_THREAD_SNAPSHOT_CHUNK` elements; the
+       * scheduler is unlocked between chunks, allowing other threads
+       * to run. Each chunk resumes the walk from the last
+       * thread copied by the previous one.
+       *
+       * A generation counter, incremented when a thread is created
+       * or destroyed, detects changes in the threads tree between
+       * chunks, which would also invalidate the resume point;
+       * in this case the copy is abandoned and `EAGAIN`
+       * is returned, and the caller may retry.
+       *
+       * @warning Cannot be invoked from Interrupt Service Routines.
+       */
+      result_t
+      threads_snapshot (thread_info* buffer, std::size_t count,
+                        std::size_t* total)
+      {
+        os_assert_err(!interrupts::in_handler_mode (), EPERM);
+        os_assert_err(buffer != nullptr, EINVAL);
+
+        thread* th = nullptr;
+        std::size_t index = 0;
+        uint32_t generation = 0;
+
+        do
+          {
+            // ----- Enter critical section -----------------------------------
+            critical_section scs;
+
+            if (index == 0)
+              {
+                generation = threads_generation_;
+                th = internal_next_thread (nullptr);
+              }
+            else if (generation != threads_generation_)
+              {
+                return EAGAIN;
+              }
+
+            // The threads past the buffer are only counted.
+            for (std::size_t n = 0;
+                th != nullptr && n < OS_INTEGER_RTOS_THREAD_SNAPSHOT_CHUNK;
+                ++n)
+              {
+                if (index < count)
+                  {
+                    snapshot_thread (*th, buffer[index]);
+                  }
+                ++index;
+                th = internal_next_thread (th);
+              }
+            // ----- Exit critical section ------------------------------------
+          }
+        while (th != nullptr);
+
+        if (total != nullptr)
+          {
+            *total = index;
+          }
+
+        return result::ok;
+      }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) */
+
     /**
      * @class critical_section
      * @details
@@ -371,9 +706,174 @@ namespace os
 
 #if !defined(OS_USE_RTOS_PORT_SCHEDULER)
 
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+      /**
+       * @cond ignore
+       */
+
+      // Threads in the EDF class are ordered before all priorities.
+      static unsigned int
+      steal_rank (const volatile internal::waiting_thread_node* node)
+      {
+        thread* th = node->thread_;
+        unsigned int rank = th->priority ();
+
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+        if (th->deadline () != 0 || th->period () != 0)
+          {
+            rank += 0x100;
+          }
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
+        return rank;
+      }
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @details
+       * Select the ready list of the next thread to run on the
+       * given core; the list is not changed.
+       *
+       * The head of the core ready list is compared with the
+       * heads of the other cores ready lists, and, if one of them
+       * is better and is allowed to run on this core, it is stolen
+       * by this core. Only the heads are inspected,
+       * so the cost depends on the number of cores, not on the
+       * number of threads.
+       *
+       * Each core has its own idle thread, so the local list is
+       * never empty, and idle cores always try to steal work.
+       *
+       * Must be called in a critical section.
+       */
+      internal::ready_threads_list*
+      internal_select_ready (std::size_t core)
+      {
+        internal::ready_threads_list* best = &ready_threads_lists_[core];
+        unsigned int best_rank =
+            best->empty () ? 0 : steal_rank (best->head ());
+
+        for (std::size_t i = 1; i < OS_INTEGER_RTOS_SCHEDULER_CORES; ++i)
+          {
+            internal::ready_threads_list* list = &ready_threads_lists_[(core
+                + i) % OS_INTEGER_RTOS_SCHEDULER_CORES];
+            if (list->empty ())
+              {
+                continue;
+              }
+
+            const volatile internal::waiting_thread_node* node = list->head ();
+            if ((node->thread_->affinity () & (1u << core)) == 0)
+              {
+                continue;
+              }
+
+            unsigned int rank = steal_rank (node);
+            if (rank > best_rank)
+              {
+                best = list;
+                best_rank = rank;
+              }
+          }
+
+        return best;
+      }
+
+      /**
+       * @details
+       * Called by the port on each secondary core, after the boot
+       * core called `scheduler::start()`, to start running threads
+       * on this core.
+       *
+       * The best thread allowed to run on the core, at worst the
+       * core idle thread, which is pinned to it, becomes the core
+       * running thread, then the port starts it, as for the boot core.
+       *
+       * @warning Cannot be invoked from Interrupt Service Routines.
+       */
+      [[noreturn]] void
+      start_core (void)
+      {
+        trace::printf ("scheduler::%s() \n", __func__);
+
+        os_assert_throw(!interrupts::in_handler_mode (), EPERM);
+        os_assert_throw(started (), EPERM);
+
+          {
+            // ----- Enter critical section -----------------------------------
+            interrupts::critical_section ics;
+
+            std::size_t core = port::scheduler::core_id ();
+            thread* th = internal_select_ready (core)->unlink_head ();
+            th->core_ = core;
+            internal_current_thread () = th;
+            // ----- Exit critical section ------------------------------------
+          }
+
+        port::scheduler::start ();
+      }
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_GUARD)
+
+      /**
+       * @cond ignore
+       */
+
+      // Validate the bottom canary and the saved stack pointer;
+      // only a few loads, so it can run on each context switch.
+      static inline void
+      check_stack_guard (thread* th)
+      {
+        class thread::stack& st = th->stack ();
+        if (st.size () == 0)
+          {
+            // Stack not managed by the RTOS.
+            return;
+          }
+
+        thread::stack::element_t* sp = port::scheduler::saved_stack_pointer (
+            th);
+        if (!st.check_bottom_magic () || sp <= st.bottom () || sp > st.top ())
+          {
+            os_rtos_thread_stack_overflow_hook (
+                reinterpret_cast<os_thread_t*> (th));
+          }
+      }
+
+      /**
+       * @endcond
+       */
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_GUARD) */
+
       void
       internal_switch_threads (void)
       {
+        // The running thread of this core.
+        thread* volatile& crt = internal_current_thread ();
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+        // Other cores may link threads to this core ready list,
+        // or steal from it, while the threads are switched.
+        interrupts::critical_section ics;
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME)
+
+        // Link to the ready list the threads resumed from interrupts
+        // since the previous context switch.
+        internal_resume_deferred ();
+
+#endif /* defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME) */
+
 #if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
 
         // Get the high resolution timestamp.
@@ -389,19 +889,84 @@ namespace os
         scheduler::statistics::cpu_cycles_ += delta;
 
         // Accumulate durations to old thread.
-        scheduler::current_thread_->statistics_.cpu_cycles_ += delta;
+        crt->statistics_.cpu_cycles_ += delta;
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+        // Accumulate durations to old thread open load window.
+        crt->statistics_.internal_roll_cpu_load_ ();
+        crt->statistics_.cpu_load_cycles_ += delta;
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) */
 
         // Remember the timestamp for the next context switch.
         scheduler::statistics::switch_timestamp_ = now;
 
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_GUARD)
+
+        // Catch the overflow close to the event, while the
+        // context is still that of the guilty thread.
+        check_stack_guard (crt);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_GUARD) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT)
+
+        // After the first floating point instruction, the thread
+        // context always includes the floating point registers.
+        if (!crt->fpu_used_ && port::scheduler::saved_fpu_context (crt))
+          {
+            crt->fpu_used_ = true;
+          }
+
+        // Integer only threads skip the floating point registers.
+        if (crt->fpu_used_)
+          {
+            port::scheduler::save_fpu_context (crt);
+          }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+
+        if (crt->budget_ != 0)
+          {
+            // If the budget is used, the old thread is not
+            // re-linked to ready, but parked until replenished.
+            crt->budget_used_ += delta;
+            crt->internal_budget_throttle_ ();
+          }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
         // Normally the old running thread must be re-linked to ready.
-        scheduler::current_thread_->internal_relink_running_ ();
+        crt->internal_relink_running_ ();
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+        // The top of the core ready list, or a better thread
+        // stolen from another core, gives the next thread to run.
+        std::size_t core = port::scheduler::core_id ();
+        crt = internal_select_ready (core)->unlink_head ();
+        crt->core_ = core;
+
+#else
 
         // The top of the ready list gives the next thread to run.
-        scheduler::current_thread_ =
-            scheduler::ready_threads_list_.unlink_head ();
+        crt = ready_threads_list_.unlink_head ();
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT)
+
+        if (crt->fpu_used_)
+          {
+            port::scheduler::restore_fpu_context (crt);
+          }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) */
 
         // ***** Pointer switched to new thread! *****
 
@@ -410,18 +975,360 @@ namespace os
         // the relink_running() will simply reschedule it,
         // otherwise the thread will be lost.
 
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+        // Each time a thread is scheduled, it gets a full time slice.
+        crt->quantum_left_ =
+            crt->quantum_;
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
+        if (crt->statistics_.wakeup_pending_)
+          {
+            class thread::statistics& st =
+                crt->statistics_;
+            st.wakeup_pending_ = false;
+
+            // Time spent in the ready list since the wakeup.
+            uint64_t latency = static_cast<uint64_t> (hrclock.now ()
+                - st.wakeup_timestamp_);
+
+            if (latency > st.wakeup_latency_max_)
+              {
+                st.wakeup_latency_max_ =
+                    static_cast<rtos::statistics::duration_t> (latency);
+              }
+
+            // Logarithmic buckets, the first one for less than 32 cycles.
+            std::size_t bucket = 0;
+            if (latency >= 32)
+              {
+                bucket = static_cast<std::size_t> (63
+                    - __builtin_clzll (latency)) - 4;
+                if (bucket >= thread::statistics::wakeup_latency_buckets)
+                  {
+                    bucket = thread::statistics::wakeup_latency_buckets - 1;
+                  }
+              }
+            st.wakeup_latency_[bucket]++;
+          }
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) */
+
 #if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES)
 
         // Increment global context switches.
         scheduler::statistics::context_switches_++;
 
         // Increment new thread context switches.
-        scheduler::current_thread_->statistics_.context_switches_++;
+        crt->statistics_.context_switches_++;
 
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) */
 
       }
 
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+      /**
+       * @details
+       * Called from the SysTick handler, to account the current tick
+       * to the running thread time slice.
+       *
+       * When the time slice is used, a context switch must be
+       * requested; since the running thread is re-linked at the end
+       * of the threads with the same priority, it will be rotated
+       * behind them. While the context switch is not possible,
+       * for example with the scheduler locked, the request is
+       * repeated on each tick.
+       *
+       * Must be called in a critical section.
+       */
+      bool
+      internal_check_quantum (void)
+      {
+        thread* th = internal_current_thread ();
+        if (th == nullptr || th->quantum_left_ == 0)
+          {
+            // Not started or still waiting for the context switch.
+            return true;
+          }
+
+        if (--(th->quantum_left_) != 0)
+          {
+            return false;
+          }
+
+        // Count only the slices that rotate the thread, i.e. when
+        // a peer with the same priority is ready; the idle thread
+        // is never rotated.
+        thread::priority_t prio = th->priority ();
+        if (prio != thread::priority::idle)
+          {
+
+            internal::ready_threads_list& list = th->internal_ready_list_ ();
+            if (!list.empty () && list.head ()->thread_->priority () == prio)
+              {
+                ++statistics::quantum_expirations_;
+              }
+          }
+
+        return true;
+      }
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+
+      /**
+       * @details
+       * Called from the SysTick handler, to check if the running
+       * thread used its CPU budget, including the cycles since
+       * the last context switch.
+       *
+       * When the budget is used, a context switch must be requested;
+       * `internal_switch_threads()` will throttle the thread.
+       *
+       * Must be called in a critical section.
+       */
+      bool
+      internal_check_budget (void)
+      {
+        thread* th = internal_current_thread ();
+        if (th == nullptr || th->budget_ == 0)
+          {
+            return false;
+          }
+
+        th->internal_budget_replenish_ (sysclock.steady_now ());
+
+        rtos::statistics::duration_t used = th->budget_used_
+            + static_cast<rtos::statistics::duration_t> (hrclock.now ()
+                - statistics::switch_timestamp_);
+
+        return (used >= th->budget_);
+      }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
+#if defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME)
+
+      /**
+       * @details
+       * Add the thread to the list of deferred threads, without
+       * entering a critical section, so interrupts are never
+       * disabled, regardless of the length of the ready list.
+       *
+       * The thread is linked to the ready list later,
+       * by `internal_switch_threads()`.
+       *
+       * If the thread is already in the deferred list,
+       * the request is ignored.
+       *
+       * The wake-up time used by the latency statistics is
+       * recorded here, not when the thread is linked to the ready list.
+       *
+       * On ARMv6-M there are no exclusive access instructions and
+       * the atomic exchanges would require `libatomic`, which is not
+       * available; there a short critical section, independent of
+       * the length of the ready list, is used instead.
+       *
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      void
+      internal_defer_resume (thread* th)
+      {
+#if defined(__ARM_ARCH_6M__)
+
+          {
+            // ----- Enter critical section -------------------------------
+            interrupts::critical_section ics;
+
+            if (th->deferred_pending_)
+              {
+                // Already in the list.
+                return;
+              }
+            th->deferred_pending_ = true;
+            // ----- Exit critical section --------------------------------
+          }
+
+#else
+
+        if (__atomic_exchange_n (&th->deferred_pending_, true,
+                                 __ATOMIC_ACQUIRE))
+          {
+            // Already in the list.
+            return;
+          }
+
+#endif /* defined(__ARM_ARCH_6M__) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
+        // The thread is not visible to the drain until pushed,
+        // and no other interrupt can push it meanwhile.
+        if (th->state_ != thread::state::running)
+          {
+            th->statistics_.wakeup_timestamp_ = hrclock.now ();
+            th->statistics_.wakeup_pending_ = true;
+          }
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) */
+
+#if defined(__ARM_ARCH_6M__)
+
+          {
+            // ----- Enter critical section -------------------------------
+            interrupts::critical_section ics;
+
+            th->deferred_next_ = deferred_threads_;
+            deferred_threads_ = th;
+            // ----- Exit critical section --------------------------------
+          }
+
+#else
+
+        // Push the thread; the loop is retried only if a higher
+        // priority interrupt pushed another thread meanwhile.
+        thread* head = __atomic_load_n (&deferred_threads_, __ATOMIC_RELAXED);
+        do
+          {
+            th->deferred_next_ = head;
+          }
+        while (!__atomic_compare_exchange_n (&deferred_threads_, &head, th,
+                                             true, __ATOMIC_RELEASE,
+                                             __ATOMIC_RELAXED));
+
+#endif /* defined(__ARM_ARCH_6M__) */
+      }
+
+      /**
+       * @details
+       * Detach all deferred threads at once, and link them
+       * to the ready list, in the order they were resumed.
+       *
+       * Threads that were terminated meanwhile, or are
+       * already linked, are skipped.
+       *
+       * Must be called in a critical section.
+       */
+      void
+      internal_resume_deferred (void)
+      {
+#if defined(__ARM_ARCH_6M__)
+
+        // Already in a critical section, no interrupt can push meanwhile.
+        thread* th = deferred_threads_;
+        deferred_threads_ = nullptr;
+
+#else
+
+        thread* th = __atomic_exchange_n (&deferred_threads_, nullptr,
+                                          __ATOMIC_ACQUIRE);
+
+#endif /* defined(__ARM_ARCH_6M__) */
+
+        // Reverse the LIFO list, to preserve the resume order.
+        thread* fifo = nullptr;
+        while (th != nullptr)
+          {
+            thread* next = th->deferred_next_;
+            th->deferred_next_ = fifo;
+            fifo = th;
+            th = next;
+          }
+
+        while (fifo != nullptr)
+          {
+            th = fifo;
+            fifo = th->deferred_next_;
+            th->deferred_next_ = nullptr;
+
+            // From now on, the thread can be deferred again.
+            __atomic_store_n (&th->deferred_pending_, false, __ATOMIC_RELEASE);
+
+            if (th->state_ == thread::state::terminated
+                || th->state_ == thread::state::destroyed)
+              {
+                continue;
+              }
+
+            // If the thread is not already in the ready list, enqueue it.
+            if (th->ready_node_.next () == nullptr)
+              {
+                th->internal_link_ready_ ();
+                // state::ready set in above link().
+              }
+          }
+      }
+
+#endif /* defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+      /**
+       * @details
+       * Called from the SysTick handler, to close the CPU load
+       * window when its duration elapsed.
+       *
+       * The running thread is accounted up to the end of the window,
+       * as a context switch would do; the other threads close their
+       * windows lazily, when they are accounted again or when
+       * their load is queried, so the cost of this function does not
+       * depend on the number of threads.
+       */
+      void
+      internal_check_cpu_load (void)
+      {
+        if (!started ())
+          {
+            return;
+          }
+
+        // ----- Enter critical section ---------------------------------------
+        interrupts::critical_section ics;
+
+        clock::timestamp_t ticks = sysclock.now ();
+        if ((ticks - statistics::cpu_load_ticks_)
+            < OS_INTEGER_RTOS_STATISTICS_CPU_LOAD_WINDOW_TICKS)
+          {
+            return;
+          }
+
+        // Advance by whole windows, so the check latency does
+        // not accumulate in the windows start.
+        statistics::cpu_load_ticks_ += ((ticks - statistics::cpu_load_ticks_)
+            / OS_INTEGER_RTOS_STATISTICS_CPU_LOAD_WINDOW_TICKS)
+            * OS_INTEGER_RTOS_STATISTICS_CPU_LOAD_WINDOW_TICKS;
+
+        clock::timestamp_t now = hrclock.now ();
+
+        rtos::statistics::duration_t delta =
+            static_cast<rtos::statistics::duration_t> (now
+                - statistics::switch_timestamp_);
+
+        statistics::cpu_cycles_ += delta;
+        statistics::switch_timestamp_ = now;
+
+        class thread::statistics& st = internal_current_thread ()->statistics_;
+        st.cpu_cycles_ += delta;
+        st.internal_roll_cpu_load_ ();
+        st.cpu_load_cycles_ += delta;
+
+        // Remember the window length and open a new one.
+        statistics::cpu_load_window_cycles_[statistics::cpu_load_epoch_
+            % thread::statistics::cpu_load_windows] =
+            static_cast<rtos::statistics::duration_t> (now
+                - statistics::cpu_load_timestamp_);
+        statistics::cpu_load_timestamp_ = now;
+        ++statistics::cpu_load_epoch_;
+        // ----- Exit critical section ----------------------------------------
+      }
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) */
+
 #endif /* !defined(OS_USE_RTOS_PORT_SCHEDULER) */
 
       namespace statistics
@@ -439,6 +1346,45 @@ namespace os
 
 #endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
 
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+        rtos::statistics::counter_t quantum_expirations_;
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+        uint32_t cpu_load_epoch_;
+        clock::timestamp_t cpu_load_ticks_;
+        clock::timestamp_t cpu_load_timestamp_;
+        rtos::statistics::duration_t cpu_load_window_cycles_[thread::statistics::cpu_load_windows];
+
+#if !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+        /**
+         * @details
+         * The idle thread load is the complement of the system load;
+         * a watchdog can use it to detect when the application
+         * threads take too much of the CPU time.
+         *
+         * @note This function is available only when
+         * @ref OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD
+         * is defined.
+         *
+         * @warning Cannot be invoked from Interrupt Service Routines.
+         */
+        uint16_t
+        idle_cpu_load (std::size_t windows)
+        {
+          os_assert_err(os_idle_thread != nullptr, 0);
+
+          return os_idle_thread->statistics ().cpu_load (windows);
+        }
+
+#endif /* !defined(OS_USE_RTOS_PORT_SCHEDULER) */
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) */
+
       } /* namespace statistics */
 
     /**
@@ -454,6 +1400,12 @@ namespace os
      */
     namespace interrupts
     {
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+      std::size_t critical_nesting_[OS_INTEGER_RTOS_SCHEDULER_CORES];
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
       /**
        * @class critical_section
        * @details
@@ -468,6 +1420,11 @@ namespace os
        * @note Can be nested as many times as required without problems,
        * only the outer call will re-enable the interrupts.
        *
+       * With `OS_INCLUDE_RTOS_SCHEDULER_SMP`, the outer critical
+       * section of each core also holds the lock shared by all cores,
+       * so the RTOS objects are protected from the other cores too.
+       * Uncritical sections do not release it.
+       *
        * @par Example
        *
        * @code{.cpp}
@@ -591,6 +1548,34 @@ namespace os
   } /* namespace rtos */
 } /* namespace os */
 
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_GUARD) \
+  && !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+/**
+ * @details
+ * This function is called during the context switch when the
+ * outgoing thread has the bottom stack canary overwritten, or
+ * the saved stack pointer outside the stack limits.
+ *
+ * It runs in the context switch handler, with the thread context
+ * already saved, so the thread stack can be inspected with
+ * the debugger.
+ *
+ * The default implementation prints a message and aborts;
+ * the application can redefine it to log the event and reset
+ * the device.
+ */
+void __attribute__((weak))
+os_rtos_thread_stack_overflow_hook (struct os_thread_s* thread)
+{
+  os::rtos::thread* th = reinterpret_cast<os::rtos::thread*> (thread);
+  os::trace::printf ("%s() @%p %s\n", __func__, th, th->name ());
+
+  std::abort ();
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_GUARD) */
+
 int*
 __errno (void);
 
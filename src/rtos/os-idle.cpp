@@ -40,6 +40,14 @@ os_idle (thread::func_args_t args);
 void
 os_rtos_idle_actions (void);
 
+#if defined(OS_INCLUDE_RTOS_THREAD_REAPER) \
+  && !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+void*
+os_reaper (thread::func_args_t args);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_REAPER) */
+
 /**
  * @details
  * The hook must check an application specific condition to determine
@@ -69,21 +77,8 @@ void
 __attribute__((weak))
 os_rtos_idle_actions (void)
 {
-  while (!scheduler::terminated_threads_list_.empty ())
-    {
-      internal::waiting_thread_node* node;
-        {
-          // ----- Enter critical section ---------------------------------
-          interrupts::critical_section ics;
-          node =
-              const_cast<internal::waiting_thread_node*> (scheduler::terminated_threads_list_.head ());
-          node->unlink ();
-          // ----- Exit critical section ----------------------------------
-        }
-      node->thread_->internal_destroy_ ();
-
-      this_thread::yield ();
-    }
+  // With the reaper thread, this is only a fallback.
+  scheduler::internal_destroy_terminated ();
 
 #if defined(OS_HAS_INTERRUPTS_STACK)
   // Simple test to verify that the interrupts
@@ -93,6 +88,16 @@ os_rtos_idle_actions (void)
 
   if (!os_rtos_idle_enter_power_saving_mode_hook ())
     {
+#if defined(OS_INCLUDE_RTOS_TICKLESS_IDLE)
+
+      // If the next timestamp is far enough, sleep without ticks.
+      if (sysclock.internal_tickless_sleep ())
+        {
+          return;
+        }
+
+#endif /* defined(OS_INCLUDE_RTOS_TICKLESS_IDLE) */
+
       port::scheduler::wait_for_interrupt ();
     }
 }
@@ -113,8 +118,22 @@ thread* os_idle_thread;
 #pragma clang diagnostic ignored "-Wmissing-variable-declarations"
 #endif
 
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+// One idle thread for each core, created at startup.
 #if defined(OS_EXCLUDE_DYNAMIC_MEMORY_ALLOCATIONS)
 
+using idle_thread = thread_inclusive<OS_INTEGER_RTOS_IDLE_STACK_SIZE_BYTES>;
+static std::aligned_storage<sizeof(idle_thread), alignof(idle_thread)>::type os_idle_threads_[OS_INTEGER_RTOS_SCHEDULER_CORES];
+
+#else
+
+static std::unique_ptr<thread> os_idle_threads_[OS_INTEGER_RTOS_SCHEDULER_CORES];
+
+#endif /* defined(OS_EXCLUDE_DYNAMIC_MEMORY_ALLOCATIONS) */
+
+#elif defined(OS_EXCLUDE_DYNAMIC_MEMORY_ALLOCATIONS)
+
 static thread_inclusive<OS_INTEGER_RTOS_IDLE_STACK_SIZE_BYTES> os_idle_thread_
   { "idle", os_idle, nullptr};
 
@@ -122,7 +141,7 @@ static thread_inclusive<OS_INTEGER_RTOS_IDLE_STACK_SIZE_BYTES> os_idle_thread_
 
 static std::unique_ptr<thread> os_idle_thread_;
 
-#endif /* defined(OS_EXCLUDE_DYNAMIC_MEMORY_ALLOCATIONS) */
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
 
 #pragma GCC diagnostic pop
 
@@ -130,7 +149,41 @@ void
 __attribute__((weak))
 os_startup_create_thread_idle (void)
 {
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+  // Each idle thread is pinned to its core, so that all cores
+  // always have a thread to run.
+  thread::attributes attr = thread::initializer;
+  for (std::size_t core = 0; core < OS_INTEGER_RTOS_SCHEDULER_CORES; ++core)
+    {
+      attr.th_affinity = 1u << core;
+
+#if defined(OS_EXCLUDE_DYNAMIC_MEMORY_ALLOCATIONS)
+
+      // Running the constructor manually does not register
+      // any destructor, as for the main thread.
+      new (&os_idle_threads_[core]) idle_thread
+        { "idle", os_idle, nullptr, attr};
+
+#else
+
+      attr.th_stack_size_bytes = OS_INTEGER_RTOS_IDLE_STACK_SIZE_BYTES;
+
+      // No need for an explicit delete, it is deallocated by the unique_ptr.
+      os_idle_threads_[core] = std::unique_ptr<thread> (
+          new thread ("idle", os_idle, nullptr, attr));
+
+#endif /* defined(OS_EXCLUDE_DYNAMIC_MEMORY_ALLOCATIONS) */
+    }
+
+  // The idle thread of the first core is used for statistics.
 #if defined(OS_EXCLUDE_DYNAMIC_MEMORY_ALLOCATIONS)
+  os_idle_thread = reinterpret_cast<idle_thread*> (&os_idle_threads_[0]);
+#else
+  os_idle_thread = os_idle_threads_[0].get ();
+#endif /* defined(OS_EXCLUDE_DYNAMIC_MEMORY_ALLOCATIONS) */
+
+#elif defined(OS_EXCLUDE_DYNAMIC_MEMORY_ALLOCATIONS)
 
   // The thread object instance was created by the static constructors.
   os_idle_thread = &os_idle_thread_;
@@ -146,7 +199,7 @@ os_startup_create_thread_idle (void)
 
   os_idle_thread = os_idle_thread_.get ();
 
-#endif /* defined(OS_EXCLUDE_DYNAMIC_MEMORY_ALLOCATIONS) */
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
 }
 
 void*
@@ -174,6 +227,75 @@ os_idle (thread::func_args_t args __attribute__((unused)))
     }
 }
 
+#if defined(OS_INCLUDE_RTOS_THREAD_REAPER)
+
+extern thread* os_reaper_thread;
+
+thread* os_reaper_thread;
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wexit-time-destructors"
+#pragma clang diagnostic ignored "-Wglobal-constructors"
+#pragma clang diagnostic ignored "-Wmissing-variable-declarations"
+#endif
+
+#if defined(OS_EXCLUDE_DYNAMIC_MEMORY_ALLOCATIONS)
+
+static thread_inclusive<OS_INTEGER_RTOS_REAPER_STACK_SIZE_BYTES> os_reaper_thread_
+  { "reaper", os_reaper, nullptr};
+
+#else
+
+static std::unique_ptr<thread> os_reaper_thread_;
+
+#endif /* defined(OS_EXCLUDE_DYNAMIC_MEMORY_ALLOCATIONS) */
+
+#pragma GCC diagnostic pop
+
+void
+__attribute__((weak))
+os_startup_create_thread_reaper (void)
+{
+#if defined(OS_EXCLUDE_DYNAMIC_MEMORY_ALLOCATIONS)
+
+  // The thread object instance was created by the static constructors.
+  os_reaper_thread = &os_reaper_thread_;
+
+#else
+
+  thread::attributes attr = thread::initializer;
+  attr.th_stack_size_bytes = OS_INTEGER_RTOS_REAPER_STACK_SIZE_BYTES;
+
+  // No need for an explicit delete, it is deallocated by the unique_ptr.
+  os_reaper_thread_ = std::unique_ptr<thread> (
+      new thread ("reaper", os_reaper, nullptr, attr));
+
+  os_reaper_thread = os_reaper_thread_.get ();
+
+#endif /* defined(OS_EXCLUDE_DYNAMIC_MEMORY_ALLOCATIONS) */
+}
+
+void*
+os_reaper (thread::func_args_t args __attribute__((unused)))
+{
+  // Run above the normal threads, so that the terminated threads
+  // are destroyed, and their stacks deallocated, even when
+  // the idle thread does not get a chance to run.
+  this_thread::thread ().priority (thread::priority::above_normal);
+
+  while (true)
+    {
+      // Raised by each exiting thread.
+      this_thread::flags_wait (1, nullptr,
+                               flags::mode::any | flags::mode::clear);
+
+      scheduler::internal_destroy_terminated ();
+    }
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_REAPER) */
+
 /**
  * @endcond
  */
@@ -170,8 +170,15 @@ main (int argc, char* argv[])
 
 #if !defined(OS_USE_RTOS_PORT_SCHEDULER)
   os_startup_create_thread_idle ();
+#if defined(OS_INCLUDE_RTOS_THREAD_REAPER)
+  os_startup_create_thread_reaper ();
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_REAPER) */
 #endif /* !defined(OS_USE_RTOS_PORT_SCHEDULER) */
 
+#if defined(OS_INCLUDE_RTOS_TIMER_DAEMON)
+  os_startup_create_thread_timer_daemon ();
+#endif /* defined(OS_INCLUDE_RTOS_TIMER_DAEMON) */
+
   // Execution will proceed to first registered thread, possibly
   // "idle", which will immediately lower its priority,
   // and at a certain moment will reach os_main().
@@ -0,0 +1,228 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cmsis-plus/rtos/os.h>
+
+// ----------------------------------------------------------------------------
+
+namespace os
+{
+  namespace rtos
+  {
+    // ------------------------------------------------------------------------
+
+    /**
+     * @class thread_pool
+     * @details
+     * A thread pool keeps a fixed number of worker threads parked
+     * on a work queue; dispatching a work function is a message
+     * queue send, and the first idle worker runs it.
+     *
+     * Compared to creating a thread for each short lived work,
+     * there is no stack allocation, no thread creation and
+     * no deferred destruction by the idle thread.
+     *
+     * Works are executed in the order they were submitted,
+     * but, with more than one worker, they may complete in any
+     * order.
+     *
+     * @par Example
+     *
+     * @code{.cpp}
+     * void
+     * func (void* args)
+     * {
+     *   // Do something.
+     *   ...
+     * }
+     *
+     * thread_pool_inclusive<4, 16> pool { "pool" };
+     *
+     * void
+     * handle_request (void* request)
+     * {
+     *   pool.submit (func, request);
+     * }
+     * @endcode
+     *
+     * @par POSIX compatibility
+     *  No POSIX similar functionality identified.
+     */
+
+    /**
+     * @cond ignore
+     */
+
+    thread_pool::thread_pool (const char* name, message_queue& queue,
+                              std::size_t workers) :
+        object_named
+          { name }, //
+        queue_ (queue), //
+        workers_ (workers)
+    {
+#if defined(OS_TRACE_RTOS_THREAD)
+      trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+#endif
+    }
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @details
+     * The workers are stopped and destroyed by the derived class.
+     */
+    thread_pool::~thread_pool ()
+    {
+#if defined(OS_TRACE_RTOS_THREAD)
+      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+    }
+
+    /**
+     * @details
+     * Enqueue the work function and its arguments; if the queue
+     * is full, block until a worker takes a work.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    thread_pool::submit (func_t func, func_args_t args)
+    {
+      os_assert_err(func != nullptr, EINVAL);
+
+      work w
+        { func, args };
+      return queue_.send (&w, sizeof(w));
+    }
+
+    /**
+     * @details
+     * Enqueue the work function and its arguments, if there is
+     * space in the queue.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    result_t
+    thread_pool::try_submit (func_t func, func_args_t args)
+    {
+      os_assert_err(func != nullptr, EINVAL);
+
+      work w
+        { func, args };
+      return queue_.try_send (&w, sizeof(w));
+    }
+
+    /**
+     * @details
+     * Enqueue the work function and its arguments; if the queue
+     * is full, block until a worker takes a work or the timeout
+     * expires.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    thread_pool::timed_submit (func_t func, func_args_t args,
+                               clock::duration_t timeout)
+    {
+      os_assert_err(func != nullptr, EINVAL);
+
+      work w
+        { func, args };
+      return queue_.timed_send (&w, sizeof(w), timeout);
+    }
+
+    /**
+     * @cond ignore
+     */
+
+    void*
+    thread_pool::internal_run_ (void* args)
+    {
+      thread_pool* self = static_cast<thread_pool*> (args);
+
+      while (true)
+        {
+          work w;
+          if (self->queue_.receive (&w, sizeof(w)) != result::ok)
+            {
+              continue;
+            }
+
+          if (w.func == nullptr)
+            {
+              // Stop request, enqueued by the destructor.
+              break;
+            }
+
+            {
+              // ----- Enter critical section -----------------------------
+              interrupts::critical_section ics;
+
+              ++self->busy_;
+              // ----- Exit critical section ------------------------------
+            }
+
+          w.func (w.args);
+
+            {
+              // ----- Enter critical section -----------------------------
+              interrupts::critical_section ics;
+
+              --self->busy_;
+              // ----- Exit critical section ------------------------------
+            }
+        }
+
+      return nullptr;
+    }
+
+    void
+    thread_pool::internal_stop_ (void)
+    {
+#if defined(OS_TRACE_RTOS_THREAD)
+      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      // Each worker takes one stop request, after the previous works.
+      work w
+        { nullptr, nullptr };
+      for (std::size_t i = 0; i < workers_; ++i)
+        {
+          queue_.send (&w, sizeof(w));
+        }
+    }
+
+    /**
+     * @endcond
+     */
+
+  // --------------------------------------------------------------------------
+
+  } /* namespace rtos */
+} /* namespace os */
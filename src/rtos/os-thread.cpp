@@ -27,6 +27,17 @@
 
 #include <cmsis-plus/rtos/os.h>
 #include <memory>
+#include <cstring>
+
+// ----------------------------------------------------------------------------
+
+#if defined(OS_INCLUDE_RTOS_THREAD_REAPER) \
+  && !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+// Defined in os-idle.cpp.
+extern os::rtos::thread* os_reaper_thread;
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_REAPER) */
 
 // ----------------------------------------------------------------------------
 
@@ -173,6 +184,10 @@ namespace os
       // Compute the actual size. The -1 is to leave space for the magic.
       size_bytes_ = ((static_cast<std::size_t> (p - bottom_address_) - 1)
           * sizeof(element_t));
+
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+      watermark_ = nullptr;
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
     }
 
     /**
@@ -198,9 +213,323 @@ namespace os
           ++p;
         }
 
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+
+      // The full scan may find usage below the tracked watermark.
+      if (watermark_ == nullptr || p < watermark_)
+        {
+          watermark_ = p;
+        }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
+
       return count;
     }
 
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+
+    /**
+     * @details
+     * The first call scans the entire stack, like `available()`,
+     * and remembers the lowest overwritten element; later calls
+     * scan upwards from the bottom of the stack only up to it,
+     * since the stack never shrinks, so the cost decreases as the
+     * stack usage grows.
+     *
+     * The result is the same as the one computed by `available()`,
+     * which also updates the tracked watermark.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    std::size_t
+    thread::stack::high_water_mark (void)
+    {
+      if (bottom_address_ == nullptr)
+        {
+          return 0;
+        }
+
+      element_t* limit = watermark_;
+      if (limit == nullptr)
+        {
+          limit = bottom_address_ + size_bytes_ / sizeof(element_t);
+        }
+
+      element_t* p = bottom_address_;
+      while (p < limit && *p == magic)
+        {
+          ++p;
+        }
+      watermark_ = p;
+
+      return size_bytes_
+          - static_cast<std::size_t> (p - bottom_address_) * sizeof(element_t);
+    }
+
+    /**
+     * @cond ignore
+     */
+
+    namespace
+    {
+      // Number of threads collected with the scheduler locked,
+      // before displaying them.
+      constexpr std::size_t report_chunk = 8;
+
+      // Thread names are copied, the threads may be destroyed
+      // before they are displayed; longer names are truncated.
+      constexpr std::size_t report_name_size = 16;
+
+      struct stack_usage
+      {
+        char name[report_name_size];
+        std::size_t depth;
+        std::size_t used;
+        std::size_t size;
+      };
+
+      void
+      print_stack (const char* name, std::size_t depth, std::size_t used,
+                   std::size_t size)
+      {
+        trace::printf ("%*s%s: %u/%u bytes (%u%%)\n",
+                       static_cast<int> (depth * 2), "", name,
+                       static_cast<unsigned int> (used),
+                       static_cast<unsigned int> (size),
+                       static_cast<unsigned int> (used * 100 / size));
+      }
+    } /* namespace */
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @details
+     * Walk the tree of threads and display, on the trace
+     * channel, the maximum stack usage of each thread, followed by
+     * the interrupts stack, if present.
+     *
+     * The stacks are scanned incrementally, so calling it periodically
+     * is cheap.
+     *
+     * The values are collected with the scheduler locked, a few
+     * threads at a time, and are displayed after unlocking it,
+     * so the trace output does not delay the other threads.
+     * Each chunk resumes the walk from the last thread collected;
+     * if threads are created or destroyed meanwhile, the resume
+     * point may be gone, and the report ends early.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    void
+    thread::stack::report (void)
+    {
+      stack_usage buffer[report_chunk];
+      thread* th = nullptr;
+      uint32_t generation = 0;
+      bool first = true;
+
+      trace::printf ("Stack high water marks:\n");
+
+      do
+        {
+          std::size_t count = 0;
+
+            {
+              // ----- Enter critical section ---------------------------------
+              scheduler::critical_section scs;
+
+              if (first)
+                {
+                  generation = scheduler::threads_generation_;
+                  th = scheduler::internal_next_thread (nullptr);
+                  first = false;
+                }
+              else if (generation != scheduler::threads_generation_)
+                {
+                  trace::printf ("  (threads changed, report incomplete)\n");
+                  break;
+                }
+
+              for (; th != nullptr && count < report_chunk;
+                  th = scheduler::internal_next_thread (th))
+                {
+                  class thread::stack& st = th->stack ();
+                  if (st.size () == 0)
+                    {
+                      // Stack not managed by the RTOS.
+                      continue;
+                    }
+
+                  stack_usage& usage = buffer[count++];
+
+                  std::strncpy (usage.name, th->name (), report_name_size - 1);
+                  usage.name[report_name_size - 1] = '\0';
+
+                  usage.depth = 1;
+                  for (thread* p = th->parent_; p != nullptr; p = p->parent_)
+                    {
+                      ++usage.depth;
+                    }
+
+                  usage.size = st.size ();
+                  usage.used = st.high_water_mark ();
+                }
+              // ----- Exit critical section ----------------------------------
+            }
+
+          for (std::size_t i = 0; i < count; ++i)
+            {
+              stack_usage& usage = buffer[i];
+              print_stack (usage.name, usage.depth, usage.used, usage.size);
+            }
+        }
+      while (th != nullptr);
+
+#if defined(OS_HAS_INTERRUPTS_STACK)
+      class thread::stack* st = interrupts::stack ();
+      std::size_t used;
+        {
+          // ----- Enter critical section -------------------------------------
+          scheduler::critical_section scs;
+
+          used = st->high_water_mark ();
+          // ----- Exit critical section --------------------------------------
+        }
+      print_stack ("interrupts", 1, used, st->size ());
+#endif /* defined(OS_HAS_INTERRUPTS_STACK) */
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+    /**
+     * @cond ignore
+     */
+
+    static uint16_t
+    cpu_load_per_mille (rtos::statistics::duration_t cycles,
+                        rtos::statistics::duration_t window_cycles)
+    {
+      if (window_cycles == 0)
+        {
+          return 0;
+        }
+      if (cycles >= window_cycles)
+        {
+          return 1000;
+        }
+      return static_cast<uint16_t> (cycles * 1000 / window_cycles);
+    }
+
+    /**
+     * @details
+     * Close the thread open window, if the scheduler already
+     * opened a new one, and clear the windows passed while the
+     * thread did not run.
+     *
+     * Must be called in a critical section.
+     */
+    void
+    thread::statistics::internal_roll_cpu_load_ (void)
+    {
+      uint32_t epoch = scheduler::statistics::cpu_load_epoch_;
+      if (cpu_load_epoch_ == epoch)
+        {
+          return;
+        }
+
+      if ((epoch - cpu_load_epoch_) < cpu_load_windows)
+        {
+          std::size_t i = cpu_load_epoch_ % cpu_load_windows;
+          cpu_load_[i] = cpu_load_per_mille (
+              cpu_load_cycles_, scheduler::statistics::cpu_load_window_cycles_[i]);
+
+          for (uint32_t e = cpu_load_epoch_ + 1; e != epoch; ++e)
+            {
+              cpu_load_[e % cpu_load_windows] = 0;
+            }
+        }
+      else
+        {
+          for (std::size_t i = 0; i < cpu_load_windows; ++i)
+            {
+              cpu_load_[i] = 0;
+            }
+        }
+
+      cpu_load_cycles_ = 0;
+      cpu_load_epoch_ = epoch;
+    }
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @details
+     * The scheduler splits the time in windows of
+     * @ref OS_INTEGER_RTOS_STATISTICS_CPU_LOAD_WINDOW_TICKS
+     * each, and for every thread it keeps the share of each window
+     * used by the thread, for the last `cpu_load_windows` windows.
+     *
+     * The function returns the average of the most recent closed
+     * windows; with the default one second windows, 1, 10 and 60
+     * give the usual 1s/10s/60s load averages.
+     *
+     * Before enough windows were closed, the average is computed
+     * only over the available windows.
+     *
+     * @note This function is available only when
+     * @ref OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD
+     * is defined.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    uint16_t
+    thread::statistics::cpu_load (std::size_t windows)
+    {
+      assert (windows > 0 && windows <= cpu_load_windows);
+
+      uint32_t sum = 0;
+      std::size_t count = 0;
+
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          uint32_t epoch = scheduler::statistics::cpu_load_epoch_;
+          for (; count < windows && count < epoch; ++count)
+            {
+              uint32_t e = epoch - 1 - static_cast<uint32_t> (count);
+              std::size_t i = e % cpu_load_windows;
+              if (e == cpu_load_epoch_)
+                {
+                  // The thread window was not yet closed.
+                  sum += cpu_load_per_mille (
+                      cpu_load_cycles_,
+                      scheduler::statistics::cpu_load_window_cycles_[i]);
+                }
+              else if (e < cpu_load_epoch_)
+                {
+                  sum += cpu_load_[i];
+                }
+              // Otherwise the thread did not run in the window.
+            }
+          // ----- Exit critical section --------------------------------------
+        }
+
+      if (count == 0)
+        {
+          return 0;
+        }
+      return static_cast<uint16_t> (sum / count);
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) */
+
     /**
      * @cond ignore
      */
@@ -386,6 +715,22 @@ namespace os
      * @cond ignore
      */
 
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+    // Keep only the existing cores; 0 means all cores.
+    static thread::affinity_t
+    existing_cores (thread::affinity_t mask)
+    {
+      constexpr thread::affinity_t all =
+          (OS_INTEGER_RTOS_SCHEDULER_CORES == 32) ?
+              0xFFFFFFFFu :
+              ((1u << OS_INTEGER_RTOS_SCHEDULER_CORES) - 1);
+
+      return (mask == 0) ? all : (mask & all);
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
     void
     thread::internal_construct_ (func_t function, func_args_t args,
                                  const attributes& attr, void* stack_address,
@@ -429,6 +774,55 @@ namespace os
           // Get attributes from user structure.
           prio_assigned_ = attr.th_priority;
 
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+          quantum_ =
+              (attr.th_quantum_ticks != 0) ?
+                  attr.th_quantum_ticks :
+                  OS_INTEGER_RTOS_ROUND_ROBIN_QUANTUM_TICKS;
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+
+          deadline_ = attr.th_deadline_ticks;
+          period_ = attr.th_period_ticks;
+
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+          affinity_ = existing_cores (attr.th_affinity);
+          os_assert_throw(affinity_ != 0, EINVAL);
+
+          // Start on the first allowed core; idle cores will steal it.
+          core_ = static_cast<std::size_t> (__builtin_ctz (affinity_));
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+
+          os_assert_throw(
+              attr.th_budget_cycles == 0 || attr.th_budget_period_ticks != 0,
+              EINVAL);
+          budget_ = attr.th_budget_cycles;
+          budget_period_ = attr.th_budget_period_ticks;
+          budget_replenish_ = sysclock.steady_now () + budget_period_;
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT)
+
+          fpu_used_ = attr.th_fpu_used;
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) */
+
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK)
+
+          slack_ = attr.th_slack;
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) */
+
           func_ = function;
           func_args_ = args;
 
@@ -442,6 +836,11 @@ namespace os
               scheduler::top_threads_list_.link (*this);
             }
 
+#if defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) \
+  || defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+          ++scheduler::threads_generation_;
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) || defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
+
           stack ().initialize ();
 
 #if defined(OS_USE_RTOS_PORT_SCHEDULER)
@@ -458,7 +857,7 @@ namespace os
 
           if (!scheduler::started ())
             {
-              scheduler::current_thread_ = this;
+              scheduler::internal_current_thread () = this;
             }
 
           // Add to ready list, but do not yield yet.
@@ -542,6 +941,20 @@ namespace os
 
       assert (port::interrupts::is_priority_valid ());
 
+#if defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME)
+
+      if (interrupts::in_handler_mode () && scheduler::started ())
+        {
+          // Do not enter a critical section to access the ready list,
+          // the thread will be linked during the next context switch.
+          scheduler::internal_defer_resume (this);
+
+          scheduler::internal_reschedule ();
+          return;
+        }
+
+#endif /* defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME) */
+
         {
           // ----- Enter critical section -------------------------------------
           interrupts::critical_section ics;
@@ -549,13 +962,13 @@ namespace os
           // If the thread is not already in the ready list, enqueue it.
           if (ready_node_.next () == nullptr)
             {
-              scheduler::ready_threads_list_.link (ready_node_);
+              internal_link_ready_ ();
               // state::ready set in above link().
             }
           // ----- Exit critical section --------------------------------------
         }
 
-      port::scheduler::reschedule ();
+      scheduler::internal_reschedule ();
 
 #endif
 
@@ -605,85 +1018,49 @@ namespace os
       return prio_inherited_;
     }
 
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
     /**
      * @details
-     * Set the scheduling priority for the thread to the value given
-     * by _prio_.
-     *
-     * If an implementation detects use of a thread ID after the end
-     * of its lifetime, it is recommended that the function should
-     * fail and report an `ESRCH` error.
-     *
-     * The `priority()` function shall not return an error
-     * code of `EINTR`.
+     * Set the number of SysTick ticks the thread may run before
+     * being rotated behind the other ready threads with the same
+     * priority. The new value is used starting with the next
+     * time the thread is scheduled.
      *
      * @par POSIX compatibility
-     *  Inspired by [`pthread_setschedprio()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_setschedprio.html)
-     *  from [`<pthread.h>`](http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/pthread.h.html)
-     *  ([IEEE Std 1003.1, 2013 Edition](http://pubs.opengroup.org/onlinepubs/9699919799/nframe.html)).
+     *  Extension to standard, no POSIX similar functionality identified.
      *
      * @warning Cannot be invoked from Interrupt Service Routines.
      */
     result_t
-    thread::priority (priority_t prio)
+    thread::quantum (clock::duration_t ticks)
     {
 #if defined(OS_TRACE_RTOS_THREAD)
-      trace::printf ("%s(%u) @%p %s\n", __func__, prio, this, name ());
+      trace::printf ("%s(%u) @%p %s\n", __func__, ticks, this, name ());
 #endif
 
       os_assert_err(!interrupts::in_handler_mode (), EPERM);
-      os_assert_err(prio < priority::error, EINVAL);
-      os_assert_err(prio != priority::none, EINVAL);
-
-      if (prio_assigned_ == prio)
-        {
-          // Optimise, if priority did not change.
-          return result::ok;
-        }
-
-      prio_assigned_ = prio;
-
-      result_t res = result::ok;
-
-#if defined(OS_USE_RTOS_PORT_SCHEDULER)
-
-      // The port must perform a context switch.
-      res = port::thread::priority (this, prio);
-
-#else
-
-      if (state_ == state::ready)
-        {
-          // ----- Enter critical section -------------------------------------
-          interrupts::critical_section ics;
 
-          // Remove from initial location and reinsert according
-          // to new priority.
-          ready_node_.unlink ();
-          scheduler::ready_threads_list_.link (ready_node_);
-          // ----- Exit critical section --------------------------------------
-        }
+      quantum_ = (ticks != 0) ? ticks : OS_INTEGER_RTOS_ROUND_ROBIN_QUANTUM_TICKS;
 
-      // Mandatory, the priority might have been raised, the
-      // task must be scheduled to run.
-      this_thread::yield ();
+      return result::ok;
+    }
 
-#endif
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
 
-      return res;
-    }
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
 
     /**
      * @details
-     * Set the scheduling inherited priority for the thread to the value given
-     * by _prio_.
-     *
-     * If an implementation detects use of a thread ID after the end
-     * of its lifetime, it is recommended that the function should
-     * fail and report an `ESRCH` error.
+     * Move the thread to the earliest deadline first class, or,
+     * if both values are 0, back to the priority scheduling.
      *
-     * The `priority()` function shall not return an error
-     * code of `EINTR`.
+     * Each time the thread is woken up, its absolute deadline is
+     * computed by adding the relative deadline (or the period, if
+     * the relative deadline is 0) to the current sysclock time.
+     * Ready threads in the EDF class are ordered by their
+     * absolute deadlines, and all are scheduled before the threads
+     * scheduled by priority.
      *
      * @par POSIX compatibility
      *  Extension to standard, no POSIX similar functionality identified.
@@ -691,22 +1068,506 @@ namespace os
      * @warning Cannot be invoked from Interrupt Service Routines.
      */
     result_t
-    thread::priority_inherited (priority_t prio)
+    thread::deadline (clock::duration_t ticks, clock::duration_t period)
     {
 #if defined(OS_TRACE_RTOS_THREAD)
-      trace::printf ("%s(%u) @%p %s\n", __func__, prio, this, name ());
+      trace::printf ("%s(%u,%u) @%p %s\n", __func__, ticks, period, this,
+                     name ());
 #endif
 
       os_assert_err(!interrupts::in_handler_mode (), EPERM);
-      os_assert_err(prio < priority::error, EINVAL);
 
-      if (prio == prio_inherited_)
-        {
-          // Optimise, if priority did not change.
-          return result::ok;
-        }
+#if !defined(OS_USE_RTOS_PORT_SCHEDULER)
 
-      prio_inherited_ = prio;
+      // Only the running thread and a re-linked ready thread may
+      // change the order of the threads; other threads take the
+      // new class when resumed.
+      bool reschedule = (this == &this_thread::thread ());
+
+#endif /* !defined(OS_USE_RTOS_PORT_SCHEDULER) */
+
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          deadline_ = ticks;
+          period_ = period;
+
+          clock::duration_t relative = (ticks != 0) ? ticks : period;
+          absolute_deadline_ = sysclock.now () + relative;
+
+#if !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+          if (state_ == state::ready)
+            {
+              // Move the thread to the list of the new class.
+              ready_node_.unlink ();
+              internal_link_ready_ ();
+              reschedule = true;
+            }
+
+#endif /* !defined(OS_USE_RTOS_PORT_SCHEDULER) */
+          // ----- Exit critical section --------------------------------------
+        }
+
+#if !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+      if (reschedule)
+        {
+          this_thread::yield ();
+        }
+
+#endif /* !defined(OS_USE_RTOS_PORT_SCHEDULER) */
+
+      return result::ok;
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+    /**
+     * @details
+     * Restrict the cores the thread is allowed to run on.
+     *
+     * If the core the thread is assigned to is no longer allowed,
+     * the thread is moved to the first allowed core; a ready thread
+     * is moved to the ready list of that core, and the running
+     * thread migrates at the next context switch, which is
+     * requested immediately.
+     *
+     * @par POSIX compatibility
+     *  Inspired by `pthread_setaffinity_np()`
+     *  from the GNU C library, not part of POSIX.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    thread::affinity (affinity_t mask)
+    {
+#if defined(OS_TRACE_RTOS_THREAD)
+      trace::printf ("%s(0x%X) @%p %s\n", __func__, mask, this, name ());
+#endif
+
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+
+      mask = existing_cores (mask);
+      if (mask == 0)
+        {
+          return EINVAL;
+        }
+
+      bool migrate = false;
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          affinity_ = mask;
+
+          if ((mask & (1u << core_)) == 0)
+            {
+              core_ = static_cast<std::size_t> (__builtin_ctz (mask));
+
+              if (state_ == state::ready)
+                {
+                  // Move the thread to the ready list of the new core.
+                  ready_node_.unlink ();
+                  internal_link_ready_ ();
+                }
+              else if (state_ == state::running)
+                {
+                  migrate = true;
+                }
+            }
+          // ----- Exit critical section --------------------------------------
+        }
+
+      if (migrate && (this == &this_thread::thread ()))
+        {
+          this_thread::yield ();
+        }
+
+      return result::ok;
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+
+    /**
+     * @details
+     * The CPU time used by the thread is measured with `hrclock`
+     * during context switches, and checked on each SysTick;
+     * when the thread used its budget, it is suspended
+     * until the beginning of the next period, when it is
+     * resumed with a full budget.
+     *
+     * This limits the CPU time used by low importance threads,
+     * regardless of their priority, so they cannot starve
+     * the other threads.
+     *
+     * A new budget starts a new period; if the thread was throttled,
+     * it is resumed.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    thread::budget (rtos::statistics::duration_t cycles,
+                    clock::duration_t period_ticks)
+    {
+#if defined(OS_TRACE_RTOS_THREAD)
+      trace::printf ("%s(%u,%u) @%p %s\n", __func__,
+                     static_cast<unsigned int> (cycles), period_ticks, this,
+                     name ());
+#endif
+
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+
+      if (cycles != 0 && period_ticks == 0)
+        {
+          return EINVAL;
+        }
+
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          budget_ = cycles;
+          budget_period_ = period_ticks;
+          budget_used_ = 0;
+          budget_replenish_ = sysclock.steady_now () + period_ticks;
+
+          if (throttled_)
+            {
+              internal_budget_release_ ();
+            }
+          // ----- Exit critical section --------------------------------------
+        }
+
+      return result::ok;
+    }
+
+    /**
+     * @cond ignore
+     */
+
+    // Called from internal_switch_threads(), for the old thread,
+    // after its cycles were accounted.
+    void
+    thread::internal_budget_throttle_ (void)
+    {
+      internal_budget_replenish_ (sysclock.steady_now ());
+
+      if (budget_used_ < budget_
+          || (state_ != state::running && state_ != state::ready))
+        {
+          // Budget not used, or the thread already waits for something.
+          return;
+        }
+
+      // The thread may be in the ready list, if resumed while running.
+      ready_node_.unlink ();
+      state_ = state::suspended;
+
+      // Keep the node linked, so that resume() does not make it ready.
+      scheduler::throttled_threads_list_.link (ready_node_);
+      throttled_ = true;
+
+      budget_node_.timestamp = budget_replenish_;
+      sysclock.steady_list ().link (budget_node_);
+    }
+
+    // Must be called in a critical section.
+    void
+    thread::internal_budget_release_ (void)
+    {
+      budget_node_.unlink ();
+      internal_budget_replenish_ (sysclock.steady_now ());
+
+      ready_node_.unlink ();
+      throttled_ = false;
+
+      if (state_ != state::destroyed)
+        {
+          resume ();
+        }
+    }
+
+    /**
+     * @endcond
+     */
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK)
+
+    /**
+     * @details
+     * Allow the timeouts of all timed waits and sleeps started
+     * later by this thread to expire up to _slack_ clock units after
+     * the requested time, so that they can be coalesced with
+     * other expiries, reducing the number of wake-ups.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    thread::slack (clock::duration_t slack)
+    {
+#if defined(OS_TRACE_RTOS_THREAD)
+      trace::printf ("%s(%u) @%p %s\n", __func__, slack, this, name ());
+#endif
+
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+
+      slack_ = slack;
+
+      return result::ok;
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC)
+
+    /**
+     * @cond ignore
+     */
+
+    // One bit for each key in use.
+    static uint32_t specific_keys_;
+
+    static thread::specific_destructor_t specific_destructors_[OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS];
+
+    // Clear the value of the key in all threads of the tree.
+    static void
+    clear_specific (thread::threads_list& list, thread::specific_key_t key)
+    {
+      for (auto&& th : list)
+        {
+          th.specific (key, nullptr);
+          clear_specific (scheduler::children_threads (&th), key);
+        }
+    }
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @details
+     * Constant time access, the key is the index in the array
+     * of thread specific values.
+     *
+     * @par POSIX compatibility
+     *  Inspired by [`pthread_setspecific()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_setspecific.html)
+     *  from [`<pthread.h>`](http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/pthread.h.html)
+     *  ([IEEE Std 1003.1, 2013 Edition](http://pubs.opengroup.org/onlinepubs/9699919799/nframe.html)).
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    result_t
+    thread::specific (specific_key_t key, void* value)
+    {
+      if (key >= OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS || (specific_keys_ & (1u << key)) == 0)
+        {
+          return EINVAL;
+        }
+
+      specific_[key] = value;
+
+      return result::ok;
+    }
+
+    /**
+     * @details
+     * Allocate one of the `OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS` keys,
+     * and associate `nullptr` with it in all existing threads.
+     *
+     * When a thread is destroyed, for each key with a destructor
+     * and a non null value, the value is set to `nullptr` and the
+     * destructor is called with the previous value. The destructors
+     * run in the context of the thread destroying it (usually the
+     * idle thread), with the scheduler possibly locked.
+     *
+     * @par POSIX compatibility
+     *  Inspired by [`pthread_key_create()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_key_create.html)
+     *  from [`<pthread.h>`](http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/pthread.h.html)
+     *  ([IEEE Std 1003.1, 2013 Edition](http://pubs.opengroup.org/onlinepubs/9699919799/nframe.html)).
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    thread::specific_key_create (specific_key_t* key,
+                                 specific_destructor_t destructor)
+    {
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+
+      assert (key != nullptr);
+
+      // ----- Enter critical section -----------------------------------------
+      scheduler::critical_section scs;
+
+      uint32_t free = ~specific_keys_;
+#if OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS < 32
+      free &= (1u << OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS) - 1;
+#endif
+      if (free == 0)
+        {
+          return EAGAIN;
+        }
+
+      specific_key_t k = static_cast<specific_key_t> (__builtin_ctz (free));
+      specific_keys_ |= (1u << k);
+      specific_destructors_[k] = destructor;
+
+      clear_specific (scheduler::children_threads (nullptr), k);
+
+      *key = k;
+
+      return result::ok;
+      // ----- Exit critical section ------------------------------------------
+    }
+
+    /**
+     * @details
+     * The destructor is not called for the values still
+     * associated with the key.
+     *
+     * @par POSIX compatibility
+     *  Inspired by [`pthread_key_delete()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_key_delete.html)
+     *  from [`<pthread.h>`](http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/pthread.h.html)
+     *  ([IEEE Std 1003.1, 2013 Edition](http://pubs.opengroup.org/onlinepubs/9699919799/nframe.html)).
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    thread::specific_key_delete (specific_key_t key)
+    {
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+
+      // ----- Enter critical section -----------------------------------------
+      scheduler::critical_section scs;
+
+      if (key >= OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS || (specific_keys_ & (1u << key)) == 0)
+        {
+          return EINVAL;
+        }
+
+      specific_keys_ &= ~(1u << key);
+      specific_destructors_[key] = nullptr;
+
+      return result::ok;
+      // ----- Exit critical section ------------------------------------------
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC) */
+
+    /**
+     * @details
+     * Set the scheduling priority for the thread to the value given
+     * by _prio_.
+     *
+     * If an implementation detects use of a thread ID after the end
+     * of its lifetime, it is recommended that the function should
+     * fail and report an `ESRCH` error.
+     *
+     * The `priority()` function shall not return an error
+     * code of `EINTR`.
+     *
+     * @par POSIX compatibility
+     *  Inspired by [`pthread_setschedprio()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_setschedprio.html)
+     *  from [`<pthread.h>`](http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/pthread.h.html)
+     *  ([IEEE Std 1003.1, 2013 Edition](http://pubs.opengroup.org/onlinepubs/9699919799/nframe.html)).
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    thread::priority (priority_t prio)
+    {
+#if defined(OS_TRACE_RTOS_THREAD)
+      trace::printf ("%s(%u) @%p %s\n", __func__, prio, this, name ());
+#endif
+
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      os_assert_err(prio < priority::error, EINVAL);
+      os_assert_err(prio != priority::none, EINVAL);
+
+      if (prio_assigned_ == prio)
+        {
+          // Optimise, if priority did not change.
+          return result::ok;
+        }
+
+      prio_assigned_ = prio;
+
+      result_t res = result::ok;
+
+#if defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+      // The port must perform a context switch.
+      res = port::thread::priority (this, prio);
+
+#else
+
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          if (state_ == state::ready)
+            {
+              // Remove from initial location and reinsert according
+              // to new priority.
+              ready_node_.unlink ();
+              internal_link_ready_ ();
+            }
+          // ----- Exit critical section --------------------------------------
+        }
+
+      // Mandatory, the priority might have been raised, the
+      // task must be scheduled to run.
+      this_thread::yield ();
+
+#endif
+
+      return res;
+    }
+
+    /**
+     * @details
+     * Set the scheduling inherited priority for the thread to the value given
+     * by _prio_.
+     *
+     * If an implementation detects use of a thread ID after the end
+     * of its lifetime, it is recommended that the function should
+     * fail and report an `ESRCH` error.
+     *
+     * The `priority()` function shall not return an error
+     * code of `EINTR`.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    thread::priority_inherited (priority_t prio)
+    {
+#if defined(OS_TRACE_RTOS_THREAD)
+      trace::printf ("%s(%u) @%p %s\n", __func__, prio, this, name ());
+#endif
+
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      os_assert_err(prio < priority::error, EINVAL);
+
+      if (prio == prio_inherited_)
+        {
+          // Optimise, if priority did not change.
+          return result::ok;
+        }
+
+      prio_inherited_ = prio;
 
       if (prio_inherited_ < prio_assigned_)
         {
@@ -723,15 +1584,17 @@ namespace os
 
 #else
 
-      if (state_ == state::ready)
         {
           // ----- Enter critical section -------------------------------------
           interrupts::critical_section ics;
 
-          // Remove from initial location and reinsert according
-          // to new priority.
-          ready_node_.unlink ();
-          scheduler::ready_threads_list_.link (ready_node_);
+          if (state_ == state::ready)
+            {
+              // Remove from initial location and reinsert according
+              // to new priority.
+              ready_node_.unlink ();
+              internal_link_ready_ ();
+            }
           // ----- Exit critical section --------------------------------------
         }
 
@@ -847,6 +1710,41 @@ namespace os
       return result::ok;
     }
 
+    /**
+     * @details
+     * Suspend execution of the calling thread until all threads
+     * in the array terminate. The threads are joined in the array
+     * order, but, since they are destroyed as soon as they terminate,
+     * the total wait is given by the thread that terminates last.
+     *
+     * @par POSIX compatibility
+     *  Extension to standard, no POSIX similar functionality identified.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    thread::join_all (thread* threads[], std::size_t count, void** exit_ptrs)
+    {
+#if defined(OS_TRACE_RTOS_THREAD)
+      trace::printf ("%s(%u)\n", __func__, static_cast<unsigned int> (count));
+#endif
+
+      os_assert_err(!interrupts::in_handler_mode (), EPERM);
+      os_assert_err(threads != nullptr, EINVAL);
+
+      for (std::size_t i = 0; i < count; ++i)
+        {
+          result_t res = threads[i]->join (
+              (exit_ptrs != nullptr) ? &exit_ptrs[i] : nullptr);
+          if (res != result::ok)
+            {
+              return res;
+            }
+        }
+
+      return result::ok;
+    }
+
     /**
      * @details
      *
@@ -955,6 +1853,11 @@ namespace os
               ready_node_.unlink ();
 
               child_links_.unlink ();
+
+#if defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) \
+  || defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+              ++scheduler::threads_generation_;
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) || defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
               // ----- Exit critical section ----------------------------------
             }
 
@@ -978,6 +1881,17 @@ namespace os
           // ----- Exit critical section --------------------------------------
         }
 
+#if defined(OS_INCLUDE_RTOS_THREAD_REAPER) \
+  && !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+      // Do not wait for the idle thread, which may not run under load.
+      if (os_reaper_thread != nullptr)
+        {
+          os_reaper_thread->flags_raise (1);
+        }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_REAPER) */
+
 #if defined(OS_USE_RTOS_PORT_SCHEDULER)
 
       port::thread::destroy_this (this);
@@ -1051,6 +1965,38 @@ namespace os
           // ----- Exit critical section --------------------------------------
         }
 
+#if defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME) \
+  && !defined(OS_USE_RTOS_PORT_SCHEDULER)
+
+      if (deferred_pending_)
+        {
+          // ----- Enter critical section -------------------------------------
+          interrupts::critical_section ics;
+
+          // Do not leave a reference to this thread in the deferred list.
+          scheduler::internal_resume_deferred ();
+          // ----- Exit critical section --------------------------------------
+        }
+
+#endif /* defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC)
+
+      for (specific_key_t key = 0; key < OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS; ++key)
+        {
+          void* value = specific_[key];
+          if (value != nullptr)
+            {
+              specific_[key] = nullptr;
+              if (specific_destructors_[key] != nullptr)
+                {
+                  specific_destructors_[key] (value);
+                }
+            }
+        }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC) */
+
       state_ = state::destroyed;
 
       if (joiner_ != nullptr)
@@ -1099,7 +2045,8 @@ namespace os
               // ----- Enter critical section ---------------------------------
               interrupts::critical_section ics;
 
-              // Remove thread from the funeral list and kill it here.
+              // Remove thread from the ready list or from the
+              // funeral list and kill it here.
               ready_node_.unlink ();
 
               // If the thread is waiting on an event, remove it from the list.
@@ -1108,6 +2055,26 @@ namespace os
                   waiting_node_->unlink ();
                 }
 
+#if defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY)
+
+              // If the thread is waiting on multiple objects, remove
+              // it from all lists.
+              for (std::size_t i = 0; i < wait_sources_count_; ++i)
+                {
+                  wait_sources_[i]->node_.unlink ();
+                }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+
+              // If the thread is throttled, remove it from the clock list;
+              // the throttled list was left with `ready_node_` above.
+              budget_node_.unlink ();
+              throttled_ = false;
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
               // If the thread is waiting on a timeout, remove it from the list.
               if (clock_node_ != nullptr)
                 {
@@ -1115,6 +2082,11 @@ namespace os
                 }
 
               child_links_.unlink ();
+
+#if defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) \
+  || defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+              ++scheduler::threads_generation_;
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) || defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
               // ----- Exit critical section ----------------------------------
             }
 
@@ -1462,7 +2434,7 @@ namespace os
 
 #else
 
-        th = scheduler::current_thread_;
+        th = scheduler::internal_current_thread ();
 
 #endif
         return th;
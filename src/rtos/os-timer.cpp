@@ -29,6 +29,110 @@
 
 // ----------------------------------------------------------------------------
 
+#if defined(OS_INCLUDE_RTOS_TIMER_DAEMON)
+
+using namespace os::rtos;
+
+/**
+ * @cond ignore
+ */
+
+extern thread* os_timer_daemon_thread;
+
+thread* os_timer_daemon_thread;
+
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wexit-time-destructors"
+#pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+
+// Expired timers, waiting for the daemon to call their functions.
+static timer::pending_list pending_timers_;
+
+#if defined(OS_EXCLUDE_DYNAMIC_MEMORY_ALLOCATIONS)
+
+static thread_inclusive<OS_INTEGER_RTOS_TIMER_DAEMON_STACK_SIZE_BYTES> os_timer_daemon_thread_
+  { "timer", os_timer_daemon, nullptr};
+
+#else
+
+static std::unique_ptr<thread> os_timer_daemon_thread_;
+
+#endif /* defined(OS_EXCLUDE_DYNAMIC_MEMORY_ALLOCATIONS) */
+
+#pragma GCC diagnostic pop
+
+void
+__attribute__((weak))
+os_startup_create_thread_timer_daemon (void)
+{
+#if defined(OS_EXCLUDE_DYNAMIC_MEMORY_ALLOCATIONS)
+
+  // The thread object instance was created by the static constructors.
+  os_timer_daemon_thread = &os_timer_daemon_thread_;
+
+#else
+
+  thread::attributes attr = thread::initializer;
+  attr.th_stack_size_bytes = OS_INTEGER_RTOS_TIMER_DAEMON_STACK_SIZE_BYTES;
+
+  // No need for an explicit delete, it is deallocated by the unique_ptr.
+  os_timer_daemon_thread_ = std::unique_ptr<thread> (
+      new thread ("timer", os_timer_daemon, nullptr, attr));
+
+  os_timer_daemon_thread = os_timer_daemon_thread_.get ();
+
+#endif /* defined(OS_EXCLUDE_DYNAMIC_MEMORY_ALLOCATIONS) */
+}
+
+void*
+os_timer_daemon (void* args __attribute__((unused)))
+{
+  this_thread::thread ().priority (OS_INTEGER_RTOS_TIMER_DAEMON_PRIORITY);
+
+  while (true)
+    {
+      // Raised by the clock interrupt, once for all timers
+      // that expired since the previous wake-up.
+      this_thread::flags_wait (1, nullptr,
+                               flags::mode::any | flags::mode::clear);
+
+      while (true)
+        {
+          timer::func_t func;
+          timer::func_args_t args;
+            {
+              // ----- Enter critical section -----------------------------
+              interrupts::critical_section ics;
+
+              if (pending_timers_.empty ())
+                {
+                  break;
+                }
+
+              timer& tm = *pending_timers_.begin ();
+              tm.pending_links_.unlink ();
+
+              func = tm.func_;
+              args = tm.func_args_;
+              // ----- Exit critical section ------------------------------
+            }
+
+          // Call the user function, with interrupts enabled.
+          func (args);
+        }
+    }
+}
+
+/**
+ * @endcond
+ */
+
+#endif /* defined(OS_INCLUDE_RTOS_TIMER_DAEMON) */
+
+// ----------------------------------------------------------------------------
+
 namespace os
 {
   namespace rtos
@@ -185,6 +289,10 @@ namespace os
       clock_ = attr.clock != nullptr ? attr.clock : &sysclock;
 #endif
 
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK) && !defined(OS_USE_RTOS_PORT_TIMER)
+      slack_ = attr.tm_slack;
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) && !defined(OS_USE_RTOS_PORT_TIMER) */
+
 #if defined(OS_USE_RTOS_PORT_TIMER)
 
       port::timer::create (this, function, args);
@@ -227,6 +335,10 @@ namespace os
             {
               timer_node_.unlink ();
             }
+
+#if defined(OS_INCLUDE_RTOS_TIMER_DAEMON)
+          pending_links_.unlink ();
+#endif /* defined(OS_INCLUDE_RTOS_TIMER_DAEMON) */
           // ----- Exit critical section --------------------------------------
         }
 
@@ -265,8 +377,18 @@ namespace os
 
       period_ = period;
 
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK) && !defined(OS_USE_RTOS_PORT_TIMER)
+
+      // Keep the exact time stamp, to re-arm periodic timers without drift.
+      due_ = clock_->steady_now () + period;
+      timer_node_.timestamp = internal::coalesced_timestamp (due_, slack_);
+
+#else
+
       timer_node_.timestamp = clock_->steady_now () + period;
 
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) && !defined(OS_USE_RTOS_PORT_TIMER) */
+
         {
           // ----- Enter critical section -------------------------------------
           interrupts::critical_section ics;
@@ -324,6 +446,11 @@ namespace os
           interrupts::critical_section ics;
 
           timer_node_.unlink ();
+
+#if defined(OS_INCLUDE_RTOS_TIMER_DAEMON)
+          // Cancel the callback not yet executed by the daemon.
+          pending_links_.unlink ();
+#endif /* defined(OS_INCLUDE_RTOS_TIMER_DAEMON) */
           // ----- Exit critical section --------------------------------------
         }
       res = result::ok;
@@ -347,7 +474,12 @@ namespace os
       if (type_ == run::periodic)
         {
           // Re-arm the timer for the next period.
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK) && !defined(OS_USE_RTOS_PORT_TIMER)
+          due_ += period_;
+          timer_node_.timestamp = internal::coalesced_timestamp (due_, slack_);
+#else
           timer_node_.timestamp += period_;
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) && !defined(OS_USE_RTOS_PORT_TIMER) */
 
           // No need for critical section in ISR.
           clock_->steady_list ().link (timer_node_);
@@ -361,6 +493,27 @@ namespace os
       trace::puts (name ());
 #endif
 
+#if defined(OS_INCLUDE_RTOS_TIMER_DAEMON)
+
+      if (os_timer_daemon_thread != nullptr)
+        {
+          // Defer the call to the daemon thread, to keep the
+          // interrupt short; if still pending, count an overrun.
+          if (pending_links_.unlinked ())
+            {
+              // No need for critical section in ISR.
+              pending_timers_.link (*this);
+              os_timer_daemon_thread->flags_raise (1);
+            }
+          else
+            {
+              ++overruns_;
+            }
+          return;
+        }
+
+#endif /* defined(OS_INCLUDE_RTOS_TIMER_DAEMON) */
+
       // Call the user function.
       func_ (func_args_);
     }
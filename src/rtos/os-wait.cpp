@@ -0,0 +1,409 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cmsis-plus/rtos/os.h>
+
+// ----------------------------------------------------------------------------
+
+#if defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY)
+
+namespace os
+{
+  namespace rtos
+  {
+    // ------------------------------------------------------------------------
+
+    /**
+     * @class wait_source
+     * @details
+     * A multiple objects wait suspends the calling thread on
+     * several objects at once, and returns when any of them
+     * fires, reporting which one.
+     *
+     * Each source has its own waiting node, linked to the waiting
+     * list of the object, so posting a semaphore, sending a message
+     * or raising event flags resumes the thread the same way
+     * as for a regular wait.
+     *
+     * The sources must be constructed by the waiting thread, and
+     * must not be shared with other threads.
+     *
+     * @par Example
+     *
+     * @code{.cpp}
+     * semaphore sem;
+     * message_queue_typed<msg_t> mq { 7 };
+     *
+     * void
+     * func (void)
+     * {
+     *   msg_t msg;
+     *
+     *   wait_source s0 { sem };
+     *   wait_source s1 { mq, &msg, sizeof(msg) };
+     *   wait_source s2 { 0x3, nullptr, flags::mode::any | flags::mode::clear };
+     *
+     *   wait_source* sources[] = { &s0, &s1, &s2 };
+     *
+     *   std::size_t index;
+     *   result_t res = this_thread::wait_any (sources, 3, &index);
+     *   if (res == result::ok)
+     *     {
+     *       switch (index)
+     *         {
+     *           ...
+     *         }
+     *     }
+     * }
+     * @endcode
+     */
+
+    /**
+     * @details
+     * When the source fires, the semaphore is decremented.
+     */
+    wait_source::wait_source (semaphore& sem) :
+        node_
+          { this_thread::thread () }, //
+        object_ (&sem), //
+        type_ (type::semaphore)
+    {
+      ;
+    }
+
+    /**
+     * @details
+     * When the source fires, the oldest highest priority message
+     * is removed from the queue and stored in the given buffer.
+     */
+    wait_source::wait_source (message_queue& mq, void* msg, std::size_t nbytes,
+                              message_queue::priority_t* mprio) :
+        node_
+          { this_thread::thread () }, //
+        object_ (&mq), //
+        msg_ (msg), //
+        nbytes_ (nbytes), //
+        mprio_ (mprio), //
+        type_ (type::message_queue)
+    {
+      ;
+    }
+
+    /**
+     * @details
+     * When the source fires, the event flags are processed
+     * as in `event_flags::wait()`.
+     */
+    wait_source::wait_source (event_flags& evf, flags::mask_t mask,
+                              flags::mask_t* oflags, flags::mode_t mode) :
+        node_
+          { this_thread::thread () }, //
+        object_ (&evf), //
+        mask_ (mask), //
+        oflags_ (oflags), //
+        mode_ (mode), //
+        type_ (type::event_flags)
+    {
+      ;
+    }
+
+    /**
+     * @details
+     * When the source fires, the current thread event flags are
+     * processed as in `this_thread::flags_wait()`.
+     */
+    wait_source::wait_source (flags::mask_t mask, flags::mask_t* oflags,
+                              flags::mode_t mode) :
+        node_
+          { this_thread::thread () }, //
+        object_ (&this_thread::thread ()), //
+        mask_ (mask), //
+        oflags_ (oflags), //
+        mode_ (mode), //
+        type_ (type::thread_flags)
+    {
+      ;
+    }
+
+    /**
+     * @details
+     * The node is not expected to be linked, since the
+     * wait functions unlink it before returning.
+     */
+    wait_source::~wait_source ()
+    {
+      assert(node_.unlinked ());
+    }
+
+    /**
+     * @cond ignore
+     */
+
+    bool
+    wait_source::internal_try_ (void)
+    {
+      switch (type_)
+        {
+        case type::semaphore:
+          return static_cast<semaphore*> (object_)->internal_try_wait_ ();
+
+        case type::message_queue:
+          return static_cast<message_queue*> (object_)->internal_try_receive_ (
+              msg_, nbytes_, mprio_);
+
+        case type::event_flags:
+          return static_cast<event_flags*> (object_)->event_flags_.check_raised (
+              mask_, oflags_, mode_);
+
+        case type::thread_flags:
+          return static_cast<thread*> (object_)->event_flags_.check_raised (
+              mask_, oflags_, mode_);
+        }
+
+      return false;
+    }
+
+    internal::waiting_threads_list*
+    wait_source::internal_list_ (void)
+    {
+      switch (type_)
+        {
+        case type::semaphore:
+          return &static_cast<semaphore*> (object_)->list_;
+
+        case type::message_queue:
+          return &static_cast<message_queue*> (object_)->receive_list_;
+
+        case type::event_flags:
+          return &static_cast<event_flags*> (object_)->list_;
+
+        case type::thread_flags:
+          // The thread is resumed directly by `flags_raise()`.
+          break;
+        }
+
+      return nullptr;
+    }
+
+    /**
+     * @details
+     * Semaphores and message queues resume a single thread
+     * when posted, and the resumed thread is expected to consume
+     * the event; if the thread selected another source, give
+     * the chance to the next waiting thread.
+     *
+     * Event flags resume all waiting threads, so there is nothing
+     * to pass on.
+     */
+    void
+    wait_source::internal_pass_on_ (wait_source* sources[], std::size_t count,
+                                    std::size_t except)
+    {
+      for (std::size_t i = 0; i < count; ++i)
+        {
+          wait_source* src = sources[i];
+          if (i != except && src->woken_
+              && (src->type_ == type::semaphore
+                  || src->type_ == type::message_queue))
+            {
+              src->internal_list_ ()->resume_one ();
+            }
+          src->woken_ = false;
+        }
+    }
+
+    result_t
+    wait_source::internal_wait_any_ (wait_source* sources[], std::size_t count,
+                                     std::size_t* index,
+                                     clock::duration_t timeout, bool blocking,
+                                     bool timed)
+    {
+      if (blocking)
+        {
+          os_assert_err(!interrupts::in_handler_mode (), EPERM);
+          os_assert_err(!scheduler::locked (), EPERM);
+        }
+
+      os_assert_err(sources != nullptr, EINVAL);
+      os_assert_err(count > 0, EINVAL);
+
+      thread& crt_thread = this_thread::thread ();
+
+#if defined(OS_TRACE_RTOS_THREAD)
+      trace::printf ("%s(%u,%u) @%p %s\n", __func__,
+                     static_cast<unsigned int> (count),
+                     static_cast<unsigned int> (timeout), &crt_thread,
+                     crt_thread.name ());
+#endif
+
+      internal::clock_timestamps_list& clock_list = sysclock.steady_list ();
+      clock::timestamp_t timeout_timestamp = sysclock.steady_now () + timeout;
+
+      // Prepare a timeout node pointing to the current thread.
+      internal::timeout_thread_node timeout_node
+        { timeout_timestamp, crt_thread };
+
+      result_t res = ENOTRECOVERABLE;
+      std::size_t selected = count;
+
+      for (;;)
+        {
+            {
+              // ----- Enter critical section ---------------------------------
+              interrupts::critical_section ics;
+
+              // Check all sources before linking any node, so that
+              // only one of them is consumed.
+              for (std::size_t i = 0; i < count; ++i)
+                {
+                  if (sources[i]->internal_try_ ())
+                    {
+                      selected = i;
+                      break;
+                    }
+                }
+
+              if (selected < count)
+                {
+                  res = result::ok;
+                  break;
+                }
+
+              if (!blocking)
+                {
+                  res = EWOULDBLOCK;
+                  break;
+                }
+
+              // Remove this thread from the ready list, if there.
+              port::this_thread::prepare_suspend ();
+
+              // Add this thread to all objects waiting lists.
+              for (std::size_t i = 0; i < count; ++i)
+                {
+                  wait_source* src = sources[i];
+                  src->node_.thread_ = &crt_thread;
+
+                  internal::waiting_threads_list* list = src->internal_list_ ();
+                  if (list != nullptr)
+                    {
+                      list->link (src->node_);
+                      if (crt_thread.waiting_node_ == nullptr)
+                        {
+                          crt_thread.waiting_node_ = &src->node_;
+                        }
+                    }
+                }
+              crt_thread.wait_sources_ = sources;
+              crt_thread.wait_sources_count_ = count;
+
+              crt_thread.state_ = thread::state::suspended;
+
+              if (timed)
+                {
+                  // Add this thread to the clock timeout list.
+                  clock_list.link (timeout_node);
+                  crt_thread.clock_node_ = &timeout_node;
+                }
+              // ----- Exit critical section ----------------------------------
+            }
+
+          port::scheduler::reschedule ();
+
+            {
+              // ----- Enter critical section ---------------------------------
+              interrupts::critical_section ics;
+
+              if (timed)
+                {
+                  // Remove the thread from the clock timeout list,
+                  // if not already removed by the timer.
+                  crt_thread.clock_node_ = nullptr;
+                  timeout_node.unlink ();
+                }
+
+              // Remove the thread from all objects waiting lists,
+              // and remember which objects already removed it.
+              for (std::size_t i = 0; i < count; ++i)
+                {
+                  wait_source* src = sources[i];
+                  if (src->internal_list_ () != nullptr)
+                    {
+                      if (src->node_.unlinked ())
+                        {
+                          src->woken_ = true;
+                        }
+                      src->node_.unlink ();
+                    }
+                }
+              crt_thread.waiting_node_ = nullptr;
+              crt_thread.wait_sources_ = nullptr;
+              crt_thread.wait_sources_count_ = 0;
+              // ----- Exit critical section ----------------------------------
+            }
+
+          if (crt_thread.interrupted ())
+            {
+              res = EINTR;
+              break;
+            }
+
+          if (timed && sysclock.steady_now () >= timeout_timestamp)
+            {
+              res = ETIMEDOUT;
+              break;
+            }
+        }
+
+      // Outside the critical section, since it may resume other threads.
+      internal_pass_on_ (sources, count, selected);
+
+      if (index != nullptr)
+        {
+          *index = selected;
+        }
+
+#if defined(OS_TRACE_RTOS_THREAD)
+      trace::printf ("%s(%u,%u) @%p %s %d\n", __func__,
+                     static_cast<unsigned int> (count),
+                     static_cast<unsigned int> (timeout), &crt_thread,
+                     crt_thread.name (), res);
+#endif
+
+      return res;
+    }
+
+  /**
+   * @endcond
+   */
+
+  } /* namespace rtos */
+} /* namespace os */
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY) */
+
+// ----------------------------------------------------------------------------
@@ -90,6 +90,40 @@
 
 // ----------------------------------------------------------------------------
 
+#if !defined(USE_FREERTOS)
+
+// Optional features of the portable scheduler, exercised by the tests.
+#define OS_INCLUDE_RTOS_READY_LIST_PRIORITY_ARRAY           (1)
+#define OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME                 (1)
+#define OS_INCLUDE_RTOS_ROUND_ROBIN                         (1)
+#define OS_INCLUDE_RTOS_EDF_SCHEDULING                      (1)
+#define OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE       (1)
+#define OS_INCLUDE_RTOS_TIMER_DAEMON                        (1)
+#define OS_INCLUDE_RTOS_THREAD_WAIT_ANY                     (1)
+#define OS_INCLUDE_RTOS_CLOCK_SEQLOCK                       (1)
+#define OS_INCLUDE_RTOS_THREAD_SNAPSHOT                     (1)
+#define OS_INCLUDE_RTOS_THREAD_SPECIFIC                     (1)
+#define OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY    (1)
+#define OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD          (1)
+#define OS_INTEGER_RTOS_STATISTICS_CPU_LOAD_WINDOW_TICKS    (10)
+
+#if !defined(__ARM_EABI__)
+// With the port functions from test-port.cpp.
+#define OS_INCLUDE_RTOS_SCHEDULER_SMP                       (1)
+#define OS_INTEGER_RTOS_SCHEDULER_CORES                     (2)
+#define OS_INCLUDE_RTOS_TICKLESS_IDLE                       (1)
+#define OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT                  (1)
+#define OS_INCLUDE_RTOS_THREAD_STACK_GUARD                  (1)
+#define OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE              (1)
+#else
+// The high resolution compare match requires the ordered clock lists.
+#define OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL                  (1)
+#endif /* !defined(__ARM_EABI__) */
+
+#endif /* !defined(USE_FREERTOS) */
+
+// ----------------------------------------------------------------------------
+
 #if defined(DEBUG)
 
 #define OS_TRACE_RTOS_CLOCKS
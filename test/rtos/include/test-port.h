@@ -0,0 +1,93 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef TEST_PORT_H_
+#define TEST_PORT_H_
+
+#include <cmsis-plus/rtos/os.h>
+
+#if defined(__cplusplus)
+
+#if !defined(__ARM_EABI__)
+
+#if defined(OS_INCLUDE_RTOS_TICKLESS_IDLE)
+
+// Number of calls to the simulated tickless sleep.
+extern std::size_t test_tickless_sleeps;
+
+// Total number of ticks slept without ticks.
+extern os::rtos::clock::duration_t test_tickless_ticks;
+
+#endif /* defined(OS_INCLUDE_RTOS_TICKLESS_IDLE) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT)
+
+constexpr std::size_t test_fpu_registers_count = 4;
+
+// The modelled floating point registers.
+extern double test_fpu_registers[test_fpu_registers_count];
+
+// Forget all saved floating point contexts.
+void
+test_fpu_clear (void);
+
+// Model the first floating point instruction of the current thread.
+void
+test_fpu_touch (void);
+
+// Number of times the thread floating point registers were
+// saved and restored since the last test_fpu_clear().
+std::size_t
+test_fpu_saves (const os::rtos::thread* th);
+
+std::size_t
+test_fpu_restores (const os::rtos::thread* th);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_GUARD)
+
+// Model a stack pointer below the bottom of the thread stack;
+// nullptr returns to stack pointers inside the stacks.
+void
+test_stack_overflow (const os::rtos::thread* th);
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_GUARD) */
+
+#if defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE)
+
+// Number of compare matches requested, and the last requested delay.
+extern std::size_t test_hrclock_compares;
+extern os::rtos::clock::duration_t test_hrclock_compare_cycles;
+
+#endif /* defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE) */
+
+#endif /* !defined(__ARM_EABI__) */
+
+#endif /* defined(__cplusplus) */
+
+#endif /* TEST_PORT_H_ */
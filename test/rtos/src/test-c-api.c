@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include <assert.h>
 #include <string.h>
+#include <errno.h>
 
 #include <test-c-api.h>
 
@@ -208,6 +209,18 @@ test_c_api (void)
 
       // An event may resume the thread before the timeout expire.
       os_sysclock_wait_for (2);
+
+#if defined(OS_INCLUDE_RTOS_THREAD_PERIODIC_SLEEP)
+      // Two releases of a periodic activity.
+      os_result_t res;
+      size_t overruns;
+      res = os_clock_sleep_until_next_period (os_clock_get_sysclock (), 2,
+                                              &overruns);
+      assert(res == ETIMEDOUT);
+      res = os_clock_sleep_until_next_period (os_clock_get_sysclock (), 2,
+                                              NULL);
+      assert(res == ETIMEDOUT);
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_PERIODIC_SLEEP) */
     }
 
   // ==========================================================================
@@ -248,6 +261,25 @@ test_c_api (void)
       os_thread_delete (th3);
     }
 
+    {
+      // Join multiple threads at once.
+      os_thread_t th4;
+      os_thread_construct (&th4, "th4", func, NULL, NULL);
+      os_thread_t th5;
+      os_thread_construct (&th5, "th5", func, NULL, NULL);
+
+      os_thread_t* ths[] =
+        { &th4, &th5 };
+      void* exit_ptrs[2];
+
+      os_result_t res;
+      res = os_thread_join_all (ths, 2, exit_ptrs);
+      assert(res == os_ok);
+
+      os_thread_destruct (&th4);
+      os_thread_destruct (&th5);
+    }
+
     {
       // Custom static thread with static stack and lower priority.
       static char stack[2 * OS_INTEGER_RTOS_DEFAULT_STACK_SIZE_BYTES];
@@ -265,6 +297,36 @@ test_c_api (void)
       prio = os_thread_get_priority (&th3);
       os_thread_set_priority (os_this_thread (), prio);
 
+#if defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET)
+      os_result_t res;
+      res = os_thread_set_budget (&th3, 1000000, 10);
+      assert(res == os_ok);
+      assert(os_thread_get_budget (&th3) == 1000000);
+      assert(!os_thread_is_throttled (&th3));
+
+      // Remove the limit.
+      res = os_thread_set_budget (&th3, 0, 0);
+      assert(res == os_ok);
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_CPU_BUDGET) */
+
+#if defined(OS_INCLUDE_RTOS_CLOCK_SLACK)
+      os_thread_set_slack (&th3, 2);
+      assert(os_thread_get_slack (&th3) == 2);
+      os_thread_set_slack (&th3, 0);
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SLACK) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT)
+      assert(!os_thread_is_fpu_used (&th3));
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) */
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+      os_thread_affinity_t mask;
+      mask = os_thread_get_affinity (&th3);
+      os_thread_set_affinity (&th3, 0x1);
+      assert(os_thread_get_core (&th3) == 0);
+      os_thread_set_affinity (&th3, mask);
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
       // Lower main thread priority to allow task to run.
       os_thread_set_priority (os_this_thread (),
                               os_thread_priority_below_normal);
@@ -352,6 +414,11 @@ test_c_api (void)
 
       os_timer_stop (&tm2);
 
+#if defined(OS_INCLUDE_RTOS_TIMER_DAEMON)
+      // At most two expiries happened while the timer ran.
+      assert(os_timer_get_overruns (&tm2) <= 2);
+#endif /* defined(OS_INCLUDE_RTOS_TIMER_DAEMON) */
+
       name = os_timer_get_name (&tm2);
       assert(strcmp (name, "tm2") == 0);
 
@@ -23,8 +23,10 @@
 #include <cmsis-plus/estd/mutex>
 
 #include <algorithm>
+#include <cstring>
 
 #include <test-cpp-api.h>
+#include <test-port.h>
 
 // ----------------------------------------------------------------------------
 
@@ -70,6 +72,503 @@ tmfunc (void* args __attribute__((unused)))
   printf ("%s\n", __func__);
 }
 
+void
+tmcount (void* args);
+
+void
+tmcount (void* args)
+{
+  ++*static_cast<int*> (args);
+}
+
+void
+tmstamp (void* args);
+
+void
+tmstamp (void* args)
+{
+  *static_cast<clock::timestamp_t*> (args) = sysclock.now ();
+}
+
+#if defined(OS_INCLUDE_RTOS_READY_LIST_PRIORITY_ARRAY) \
+  || defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME) \
+  || defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+typedef struct order_args_s
+{
+  char names[8];
+  std::size_t count;
+} order_args_t;
+
+#pragma GCC diagnostic pop
+
+void*
+order_func (void* args);
+
+// Record the order threads run, by the first letter of their names.
+void*
+order_func (void* args)
+{
+  order_args_t* oa = static_cast<order_args_t*> (args);
+
+  oa->names[oa->count++] = this_thread::thread ().name ()[0];
+
+  return nullptr;
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_READY_LIST_PRIORITY_ARRAY) || defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME) || defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+typedef struct slice_args_s
+{
+  char names[32];
+  std::size_t count;
+  clock::timestamp_t end;
+} slice_args_t;
+
+#pragma GCC diagnostic pop
+
+void*
+slice_func (void* args);
+
+// Busy loop and record each time the thread gets the CPU back.
+void*
+slice_func (void* args)
+{
+  slice_args_t* sa = static_cast<slice_args_t*> (args);
+  char name = this_thread::thread ().name ()[0];
+
+  while (sysclock.now () < sa->end)
+    {
+      // ----- Enter scheduler critical section -------------------------------
+      scheduler::critical_section scs;
+
+      if ((sa->count == 0 || sa->names[sa->count - 1] != name)
+          && sa->count < sizeof(sa->names))
+        {
+          sa->names[sa->count++] = name;
+        }
+      // ----- Exit scheduler critical section --------------------------------
+    }
+
+  return nullptr;
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
+void*
+sem_wait_func (void* args);
+
+void*
+sem_wait_func (void* args)
+{
+  static_cast<semaphore*> (args)->wait ();
+
+  return nullptr;
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+typedef struct load_args_s
+{
+  thread* main;
+  uint16_t own;
+  uint16_t other;
+  uint16_t idle;
+} load_args_t;
+
+#pragma GCC diagnostic pop
+
+void*
+load_func (void* args);
+
+// Use the CPU for a few windows, then get the loads of the last one.
+void*
+load_func (void* args)
+{
+  load_args_t* la = static_cast<load_args_t*> (args);
+
+  clock::timestamp_t begin = sysclock.now ();
+  while (sysclock.now () - begin
+      < 3 * OS_INTEGER_RTOS_STATISTICS_CPU_LOAD_WINDOW_TICKS)
+    {
+      ;
+    }
+
+  la->own = this_thread::thread ().statistics ().cpu_load (1);
+  la->other = la->main->statistics ().cpu_load (1);
+  la->idle = scheduler::statistics::idle_cpu_load (1);
+
+  return nullptr;
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) */
+
+#if defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME)
+
+void*
+sleep_order_func (void* args);
+
+// Wait to be resumed by the clock interrupt, then record the order.
+void*
+sleep_order_func (void* args)
+{
+  sysclock.sleep_for (2);
+
+  return order_func (args);
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME) */
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+typedef struct pool_args_s
+{
+  thread_pool* pool;
+  thread* caller;
+  semaphore* done;
+  int count;
+  int others;
+  std::size_t busy;
+} pool_args_t;
+
+#pragma GCC diagnostic pop
+
+void
+pool_func (void* args);
+
+// Count the works and the threads they run on.
+void
+pool_func (void* args)
+{
+  pool_args_t* pa = static_cast<pool_args_t*> (args);
+
+  ++pa->count;
+  if (&this_thread::thread () != pa->caller)
+    {
+      ++pa->others;
+    }
+  pa->busy = pa->pool->busy ();
+
+  if (pa->done != nullptr)
+    {
+      pa->done->post ();
+    }
+}
+
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_GUARD) && !defined(__ARM_EABI__)
+
+static os_thread_t* volatile stack_overflow_thread;
+static volatile std::size_t stack_overflows;
+
+// Record the overflows, instead of aborting.
+void
+os_rtos_thread_stack_overflow_hook (os_thread_t* thread)
+{
+  stack_overflow_thread = thread;
+  ++stack_overflows;
+}
+
+void*
+stack_pointer_func (void* args);
+
+// Switch while the stack pointer is modelled below the stack.
+void*
+stack_pointer_func (void* args __attribute__((unused)))
+{
+  test_stack_overflow (&this_thread::thread ());
+  sysclock.sleep_for (1);
+  test_stack_overflow (nullptr);
+
+  return nullptr;
+}
+
+void*
+stack_magic_func (void* args);
+
+// Switch while the bottom canary is overwritten.
+void*
+stack_magic_func (void* args __attribute__((unused)))
+{
+  thread::stack::element_t* bottom = this_thread::thread ().stack ().bottom ();
+  thread::stack::element_t magic = *bottom;
+
+  *bottom = ~magic;
+  sysclock.sleep_for (1);
+  *bottom = magic;
+
+  return nullptr;
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_GUARD) && !defined(__ARM_EABI__) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC)
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+typedef struct specific_args_s
+{
+  thread::specific_key_t with;
+  thread::specific_key_t without;
+  int destroyed;
+  int kept;
+  bool own;
+} specific_args_t;
+
+#pragma GCC diagnostic pop
+
+void
+specific_destructor (void* value);
+
+void
+specific_destructor (void* value)
+{
+  ++*static_cast<int*> (value);
+}
+
+void*
+specific_func (void* args);
+
+// Set values for both keys, and check they are not shared.
+void*
+specific_func (void* args)
+{
+  specific_args_t* sa = static_cast<specific_args_t*> (args);
+  thread& th = this_thread::thread ();
+
+  assert(th.specific (sa->with) == nullptr);
+
+  th.specific (sa->with, &sa->destroyed);
+  th.specific (sa->without, &sa->kept);
+
+  sa->own = (th.specific (sa->with) == &sa->destroyed);
+
+  return nullptr;
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC) */
+
+#if defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK)
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+typedef struct seqlock_args_s
+{
+  clock::timestamp_t end;
+  std::size_t reads;
+  bool monotonic;
+} seqlock_args_t;
+
+#pragma GCC diagnostic pop
+
+void*
+seqlock_func (void* args);
+
+// Read the clocks while the ticks update them; a torn read
+// would be seen as a time stamp going back.
+void*
+seqlock_func (void* args)
+{
+  seqlock_args_t* sa = static_cast<seqlock_args_t*> (args);
+
+  clock::timestamp_t ticks = sysclock.now ();
+  clock::timestamp_t steady = sysclock.steady_now ();
+  clock::timestamp_t cycles = hrclock.now ();
+
+  sa->monotonic = true;
+  while (ticks < sa->end)
+    {
+      clock::timestamp_t t = sysclock.now ();
+      clock::timestamp_t s = sysclock.steady_now ();
+      clock::timestamp_t c = hrclock.now ();
+
+      if (t < ticks || s < steady || c < cycles)
+        {
+          sa->monotonic = false;
+        }
+
+      ticks = t;
+      steady = s;
+      cycles = c;
+      ++sa->reads;
+    }
+
+  return nullptr;
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK) */
+
+#if defined(OS_INCLUDE_RTOS_TIMER_DAEMON)
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+typedef struct daemon_args_s
+{
+  thread* th;
+  bool in_handler;
+  int count;
+} daemon_args_t;
+
+#pragma GCC diagnostic pop
+
+void
+tmdaemon (void* args);
+
+// Remember the context the timer function is called from.
+void
+tmdaemon (void* args)
+{
+  daemon_args_t* da = static_cast<daemon_args_t*> (args);
+
+  da->th = &this_thread::thread ();
+  da->in_handler = interrupts::in_handler_mode ();
+  ++da->count;
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_TIMER_DAEMON) */
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE)
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+typedef struct deferred_args_s
+{
+  semaphore* sem;
+  int count;
+} deferred_args_t;
+
+#pragma GCC diagnostic pop
+
+void*
+deferred_func (void* args);
+
+void*
+deferred_func (void* args)
+{
+  deferred_args_t* da = static_cast<deferred_args_t*> (args);
+
+  da->sem->wait ();
+  ++da->count;
+
+  return nullptr;
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY)
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+typedef struct wait_args_s
+{
+  semaphore* sem1;
+  semaphore* sem2;
+  result_t res;
+  std::size_t index;
+} wait_args_t;
+
+#pragma GCC diagnostic pop
+
+void*
+wait_any_func (void* args);
+
+void*
+wait_any_func (void* args)
+{
+  wait_args_t* wa = static_cast<wait_args_t*> (args);
+
+  wait_source ws1
+    { *wa->sem1 };
+  wait_source ws2
+    { *wa->sem2 };
+  wait_source* sources[] =
+    { &ws1, &ws2 };
+
+  wa->res = this_thread::timed_wait_any (sources, 2, &wa->index, 100);
+
+  return nullptr;
+}
+
+void*
+wait_sem2_func (void* args);
+
+void*
+wait_sem2_func (void* args)
+{
+  wait_args_t* wa = static_cast<wait_args_t*> (args);
+
+  wa->res = wa->sem2->timed_wait (100);
+
+  return nullptr;
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) && !defined(__ARM_EABI__)
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+typedef struct fpu_args_s
+{
+  double value;
+  bool touch;
+  bool kept;
+} fpu_args_t;
+
+#pragma GCC diagnostic pop
+
+void*
+fpu_func (void* args);
+
+// Write the modelled floating point registers and check if they
+// are preserved while the other threads run.
+void*
+fpu_func (void* args)
+{
+  fpu_args_t* fa = static_cast<fpu_args_t*> (args);
+
+  if (fa->touch)
+    {
+      test_fpu_touch ();
+    }
+
+  fa->kept = true;
+  for (int i = 0; i < 3; ++i)
+    {
+      test_fpu_registers[0] = fa->value;
+      this_thread::yield ();
+      if (test_fpu_registers[0] != fa->value)
+        {
+          fa->kept = false;
+        }
+    }
+
+  return nullptr;
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) */
+
 #if !defined(OS_USE_RTOS_PORT_SCHEDULER)
 
 void
@@ -327,37 +826,550 @@ test_cpp_api (void)
 
   // --------------------------------------------------------------------------
 
-  using my_thread = thread_allocated<rtos::memory::allocator<thread::stack::allocation_element_t>>;
+  using my_thread = thread_allocated<rtos::memory::allocator<thread::stack::allocation_element_t>>;
+
+    {
+      // Static threads with custom allocated stacks.
+      my_thread ath1
+        { func, nullptr };
+      my_thread ath2
+        { "ath2", func, nullptr };
+
+      ath1.join ();
+      ath2.join ();
+    }
+
+  // --------------------------------------------------------------------------
+
+    {
+#pragma GCC diagnostic push
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+      // Statically allocated threads.
+      static thread_inclusive<> sth1
+        { func, nullptr };
+      static thread_inclusive<> sth2
+        { "sth2", func, nullptr };
+#pragma GCC diagnostic pop
+
+      sth1.join ();
+      sth2.join ();
+    }
+
+  // ==========================================================================
+
+  printf ("\n%s - Thread stack arenas.\n", test_name);
+
+    {
+      using arena_t = thread_stack_arena<port::stack::default_size_bytes + 1,
+      port::stack::default_size_bytes>;
+      constexpr std::size_t element_bytes =
+          sizeof(thread::stack::allocation_element_t);
+
+      // Too large for the main thread stack.
+      static arena_t arena;
+
+      static_assert(arena_t::stacks == 2, "Two stacks");
+
+      // No gaps between the stacks.
+      assert(arena_t::arena_size_bytes
+          == arena.stack_size_bytes (0) + arena.stack_size_bytes (1));
+
+      // The odd size was rounded up to a full allocation element.
+      assert(arena.stack_size_bytes (0) % element_bytes == 0);
+      assert(arena.stack_size_bytes (0)
+          == port::stack::default_size_bytes + element_bytes);
+      assert(arena.stack_size_bytes (1) == port::stack::default_size_bytes);
+
+      // The stacks are contiguous and aligned.
+      char* first = static_cast<char*> (arena.stack_address (0));
+      char* second = static_cast<char*> (arena.stack_address (1));
+      assert(second == first + arena.stack_size_bytes (0));
+      assert(reinterpret_cast<std::uintptr_t> (second) % element_bytes == 0);
+
+      thread::attributes attr0;
+      arena.assign (0, attr0);
+      thread::attributes attr1;
+      arena.assign (1, attr1);
+
+      assert(attr0.th_stack_address == first);
+      assert(attr0.th_stack_size_bytes == arena.stack_size_bytes (0));
+
+      thread th0
+        { "th0", func, nullptr, attr0 };
+      thread th1
+        { "th1", func, nullptr, attr1 };
+
+      // The threads run on the arena stacks.
+      assert(static_cast<void*> (th0.stack ().bottom ()) == first);
+      assert(static_cast<void*> (th1.stack ().bottom ()) == second);
+
+      th0.join ();
+      th1.join ();
+    }
+
+#if defined(OS_INCLUDE_RTOS_READY_LIST_PRIORITY_ARRAY)
+
+  // ==========================================================================
+
+  printf ("\n%s - Ready threads order.\n", test_name);
+
+    {
+      order_args_t args
+        { "", 0 };
+
+      thread::attributes attr_an;
+      attr_an.th_priority = thread::priority::above_normal;
+      thread::attributes attr_h;
+      attr_h.th_priority = thread::priority::high;
+
+      // Make all threads ready before any of them runs.
+      scheduler::state_t st = scheduler::lock ();
+
+      thread tha
+        { "a", order_func, &args, attr_an };
+      thread thb
+        { "b", order_func, &args, attr_h };
+      thread thc
+        { "c", order_func, &args, attr_an };
+      thread thd
+        { "d", order_func, &args, attr_h };
+      thread the
+        { "e", order_func, &args, attr_an };
+
+      // Move a ready thread to a different level; it must be
+      // linked after the threads already there.
+      result_t res = tha.priority (thread::priority::high);
+      assert(res == result::ok);
+
+      assert(args.count == 0);
+
+      scheduler::locked (st);
+
+      // Higher priorities first, FIFO within the same priority.
+      assert(args.count == 5);
+      assert(std::strncmp (args.names, "bdace", 5) == 0);
+
+      tha.join ();
+      thb.join ();
+      thc.join ();
+      thd.join ();
+      the.join ();
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_READY_LIST_PRIORITY_ARRAY) */
+
+#if defined(OS_INCLUDE_RTOS_EDF_SCHEDULING)
+
+  // ==========================================================================
+
+  printf ("\n%s - Earliest deadline first.\n", test_name);
+
+    {
+      order_args_t args
+        { "", 0 };
+
+      thread::attributes attr_a;
+      attr_a.th_deadline_ticks = 30;
+      thread::attributes attr_b;
+      attr_b.th_deadline_ticks = 10;
+      thread::attributes attr_c;
+      attr_c.th_period_ticks = 20;
+      thread::attributes attr_h;
+      attr_h.th_priority = thread::priority::high;
+
+      // Make all threads ready before any of them runs.
+      scheduler::state_t st = scheduler::lock ();
+
+      thread tha
+        { "a", order_func, &args, attr_a };
+      thread thh
+        { "h", order_func, &args, attr_h };
+      thread thb
+        { "b", order_func, &args, attr_b };
+      thread thc
+        { "c", order_func, &args, attr_c };
+
+      assert(tha.deadline () == 30);
+      assert(thc.deadline () == 0);
+      assert(thc.period () == 20);
+      assert(thh.deadline () == 0);
+      assert(thh.period () == 0);
+
+      // The first jobs were released when the threads were created.
+      assert(thb.absolute_deadline () < thc.absolute_deadline ());
+      assert(thc.absolute_deadline () < tha.absolute_deadline ());
+
+      assert(args.count == 0);
+
+      scheduler::locked (st);
+
+      // Earliest deadlines first, the deadline threads before all
+      // threads scheduled by priority.
+      assert(args.count == 4);
+      assert(std::strncmp (args.names, "bcah", 4) == 0);
+
+      tha.join ();
+      thh.join ();
+      thb.join ();
+      thc.join ();
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_EDF_SCHEDULING) */
+
+#if defined(OS_INCLUDE_RTOS_ROUND_ROBIN)
+
+  // ==========================================================================
+
+  printf ("\n%s - Round robin time slices.\n", test_name);
+
+    {
+      slice_args_t args
+        { "", 0, 0 };
+
+      thread::attributes attr;
+      attr.th_priority = thread::priority::above_normal;
+      attr.th_quantum_ticks = 2;
+
+      rtos::statistics::counter_t expirations =
+          scheduler::statistics::quantum_expirations ();
+
+      // Make both threads ready before any of them runs.
+      scheduler::state_t st = scheduler::lock ();
+
+      args.end = sysclock.now () + 20;
+
+      thread tha
+        { "a", slice_func, &args, attr };
+      thread thb
+        { "b", slice_func, &args };
+
+      assert(tha.quantum () == 2);
+      assert(thb.quantum () == OS_INTEGER_RTOS_ROUND_ROBIN_QUANTUM_TICKS);
+
+      result_t res = thb.quantum (2);
+      assert(res == result::ok);
+      assert(thb.quantum () == 2);
+
+      res = thb.priority (thread::priority::above_normal);
+      assert(res == result::ok);
+
+      scheduler::locked (st);
+
+      tha.join ();
+      thb.join ();
+
+      // Neither thread yields, so they alternate only
+      // when their time slices expire.
+      assert(args.count >= 4);
+      assert(args.names[0] == 'a');
+      assert(args.names[1] == 'b');
+      assert(args.names[2] == 'a');
+      assert(scheduler::statistics::quantum_expirations () - expirations
+          >= args.count - 1);
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_ROUND_ROBIN) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
+  // ==========================================================================
+
+  printf ("\n%s - Thread wakeup latency.\n", test_name);
+
+    {
+      semaphore sem
+        { "wl" };
+
+      thread::attributes attr;
+      attr.th_priority = thread::priority::above_normal;
+
+      // The higher priority thread runs and waits.
+      thread th
+        { "th", sem_wait_func, &sem, attr };
+
+      class thread::statistics& stat = th.statistics ();
+
+      rtos::statistics::counter_t before = 0;
+      for (std::size_t i = 0; i < thread::statistics::wakeup_latency_buckets;
+          ++i)
+        {
+          before += stat.wakeup_latency (i);
+        }
+
+      // Keep the thread ready, but not running, for a few ticks.
+      scheduler::state_t st = scheduler::lock ();
+
+      result_t res = sem.post ();
+      assert(res == result::ok);
+
+      clock::timestamp_t begin = sysclock.now ();
+      while (sysclock.now () - begin < 3)
+        {
+          ;
+        }
+
+      scheduler::locked (st);
+
+      th.join ();
+
+      rtos::statistics::counter_t after = 0;
+      for (std::size_t i = 0; i < thread::statistics::wakeup_latency_buckets;
+          ++i)
+        {
+          after += stat.wakeup_latency (i);
+        }
+
+      // Only the wakeup by the semaphore was accounted,
+      // with at least two full ticks of latency.
+      assert(after == before + 1);
+      assert(stat.wakeup_latency_max ()
+          >= 2 * (hrclock.input_clock_frequency_hz ()
+              / OS_INTEGER_SYSTICK_FREQUENCY_HZ));
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) */
+
+#if defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+  // ==========================================================================
+
+  printf ("\n%s - Thread CPU load.\n", test_name);
+
+    {
+      load_args_t args
+        { &this_thread::thread (), 0, 0, 0 };
+
+      thread::attributes attr;
+      attr.th_priority = thread::priority::above_normal;
+
+      // The higher priority thread takes all the CPU until it ends.
+      thread th
+        { "th", load_func, &args, attr };
+
+      th.join ();
+
+      // In per mille; allow for the time spent in interrupts.
+      assert(args.own >= 900);
+      assert(args.other <= 100);
+      assert(args.idle <= 100);
+      assert(args.own + args.other + args.idle <= 1000);
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) */
+
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+  // ==========================================================================
+
+  printf ("\n%s - Thread affinity.\n", test_name);
+
+    {
+      result_t res;
+
+      thread::attributes attr;
+      attr.th_affinity = 0x2; // Core 1 only.
+
+      // Keep the new thread ready while checking it.
+      scheduler::state_t st = scheduler::lock ();
+
+      thread th1
+        { "th1", func, nullptr, attr };
+
+      // Assigned to the only allowed core.
+      assert(th1.affinity () == 0x2);
+      assert(th1.core () == 1);
+
+      // No existing core, the affinity is not changed.
+      res = th1.affinity (1u << OS_INTEGER_RTOS_SCHEDULER_CORES);
+      assert(res == EINVAL);
+      assert(th1.affinity () == 0x2);
+
+      // The current core is still allowed, the thread is not moved.
+      res = th1.affinity (0x3);
+      assert(res == result::ok);
+      assert(th1.affinity () == 0x3);
+      assert(th1.core () == 1);
+
+      // The current core is no longer allowed, it moves to core 0.
+      res = th1.affinity (0x1);
+      assert(res == result::ok);
+      assert(th1.core () == 0);
+
+      // Without a mask, all cores are allowed.
+      res = th1.affinity (0);
+      assert(res == result::ok);
+      assert(th1.affinity () == (1u << OS_INTEGER_RTOS_SCHEDULER_CORES) - 1);
+      assert(th1.core () == 0);
+
+      scheduler::locked (st);
+
+      // Runs on core 0, even if core 1 is not started.
+      th1.join ();
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT)
+
+  // ==========================================================================
+
+  printf ("\n%s - Thread floating point context.\n", test_name);
+
+    {
+      thread::attributes attr;
+      attr.th_fpu_used = true;
+
+      // The scheduler is locked, so the threads did not run yet.
+      scheduler::state_t st = scheduler::lock ();
+
+      thread th1
+        { "th1", func, nullptr };
+      thread th2
+        { "th2", func, nullptr, attr };
+
+      assert(!th1.fpu_used ());
+      assert(th2.fpu_used ());
+
+      scheduler::locked (st);
+
+      th1.join ();
+      th2.join ();
+    }
+
+#if !defined(__ARM_EABI__)
+
+    {
+      test_fpu_clear ();
+
+      thread::attributes attr;
+      attr.th_fpu_used = true;
+
+      // An integer only thread, which clobbers the registers
+      // anyway, a thread declared as using them, and one
+      // detected on its first floating point instruction.
+      fpu_args_t args1
+        { 1.0, false, false };
+      fpu_args_t args2
+        { 2.0, false, false };
+      fpu_args_t args3
+        { 3.0, true, false };
+
+      scheduler::state_t st = scheduler::lock ();
+
+      thread th1
+        { "th1", fpu_func, &args1 };
+      thread th2
+        { "th2", fpu_func, &args2, attr };
+      thread th3
+        { "th3", fpu_func, &args3 };
+
+      scheduler::locked (st);
+
+      th1.join ();
+      th2.join ();
+      th3.join ();
+
+      // Only the floating point threads have their registers
+      // saved and restored.
+      assert(test_fpu_saves (&th1) == 0);
+      assert(test_fpu_restores (&th1) == 0);
+      assert(!th1.fpu_used ());
+
+      assert(test_fpu_saves (&th2) > 0);
+      assert(test_fpu_restores (&th2) > 0);
+      assert(args2.kept);
+
+      assert(th3.fpu_used ());
+      assert(test_fpu_saves (&th3) > 0);
+      assert(test_fpu_restores (&th3) > 0);
+    }
+
+#endif /* !defined(__ARM_EABI__) */
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT)
+
+  // ==========================================================================
+
+  printf ("\n%s - Threads snapshot.\n", test_name);
+
+    {
+      // Static, to keep it off the main thread stack.
+      static scheduler::thread_info info[16];
+      std::size_t count = sizeof(info) / sizeof(info[0]);
+      std::size_t base;
+      std::size_t total;
+      result_t res;
+
+      static const char* const names[] =
+        { "snap1", "snap2", "snap-with-a-long-name" };
+      static const thread::priority_t prios[] =
+        { thread::priority::low, thread::priority::normal,
+            thread::priority::high };
+
+      thread::attributes attr[3];
+      for (std::size_t i = 0; i < 3; ++i)
+        {
+          attr[i].th_priority = prios[i];
+        }
+
+      // With the scheduler locked, the threads tree cannot change
+      // between chunks, and the new threads do not run.
+      scheduler::state_t st = scheduler::lock ();
 
-    {
-      // Static threads with custom allocated stacks.
-      my_thread ath1
-        { func, nullptr };
-      my_thread ath2
-        { "ath2", func, nullptr };
+      res = scheduler::threads_snapshot (info, count, &base);
+      assert(res == result::ok);
 
-      ath1.join ();
-      ath2.join ();
-    }
+      thread th1
+        { names[0], func, nullptr, attr[0] };
+      thread th2
+        { names[1], func, nullptr, attr[1] };
+      thread th3
+        { names[2], func, nullptr, attr[2] };
+
+      res = scheduler::threads_snapshot (info, count, &total);
+      assert(res == result::ok);
+      assert(total == base + 3);
+      // More than one chunk was walked.
+      assert(total > OS_INTEGER_RTOS_THREAD_SNAPSHOT_CHUNK);
+      assert(total <= count);
+
+      for (std::size_t i = 0; i < 3; ++i)
+        {
+          std::size_t found = 0;
+          for (std::size_t j = 0; j < total; ++j)
+            {
+              if (std::strncmp (info[j].name, names[i],
+                                sizeof(info[j].name) - 1) == 0)
+                {
+                  assert(info[j].priority == prios[i]);
+                  assert(info[j].state == thread::state::ready);
+                  assert(
+                      std::strlen (info[j].name) == std::min (std::strlen (names[i]), sizeof(info[j].name) - 1));
+                  ++found;
+                }
+            }
+          assert(found == 1);
+        }
 
-  // --------------------------------------------------------------------------
+      // A short buffer still counts all threads.
+      std::size_t short_total;
+      res = scheduler::threads_snapshot (info, 1, &short_total);
+      assert(res == result::ok);
+      assert(short_total == total);
 
-    {
-#pragma GCC diagnostic push
-#if defined(__clang__)
-#pragma clang diagnostic ignored "-Wexit-time-destructors"
-#endif
-      // Statically allocated threads.
-      static thread_inclusive<> sth1
-        { func, nullptr };
-      static thread_inclusive<> sth2
-        { "sth2", func, nullptr };
-#pragma GCC diagnostic pop
+      scheduler::locked (st);
 
-      sth1.join ();
-      sth2.join ();
+      th1.join ();
+      th2.join ();
+      th3.join ();
     }
 
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SNAPSHOT) */
+
   // ==========================================================================
 
   printf ("\n%s - Thread stack.\n", test_name);
@@ -379,8 +1391,51 @@ test_cpp_api (void)
 
       stack.check_bottom_magic ();
       stack.check_top_magic ();
+
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK)
+      // The incremental scan must not report less than the full one.
+      n = stack.size () - stack.available ();
+      assert(stack.high_water_mark () >= n);
+
+      thread::stack::report ();
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_HIGH_WATER_MARK) */
+    }
+
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_GUARD) && !defined(__ARM_EABI__)
+
+  // ==========================================================================
+
+  printf ("\n%s - Thread stack guard.\n", test_name);
+
+    {
+      // No false alarms in all the context switches so far.
+      assert(stack_overflows == 0);
+
+      thread th1
+        { "th1", stack_pointer_func, nullptr };
+      th1.join ();
+
+      assert(stack_overflows == 1);
+      assert(stack_overflow_thread == reinterpret_cast<os_thread_t*> (&th1));
+
+      thread th2
+        { "th2", stack_magic_func, nullptr };
+      th2.join ();
+
+      assert(stack_overflows == 2);
+      assert(stack_overflow_thread == reinterpret_cast<os_thread_t*> (&th2));
+
+      // Each overflow is reported on the context switch
+      // from the guilty thread, not later.
+      thread th3
+        { "th3", func, nullptr };
+      th3.join ();
+
+      assert(stack_overflows == 2);
     }
 
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_GUARD) && !defined(__ARM_EABI__) */
+
   // ==========================================================================
 
   printf ("\n%s - Thread event flags.\n", test_name);
@@ -398,6 +1453,128 @@ test_cpp_api (void)
       this_thread::flags_timed_wait (0x3, 10);
     }
 
+#if defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC)
+
+  // ==========================================================================
+
+  printf ("\n%s - Thread specific data.\n", test_name);
+
+    {
+      specific_args_t args
+        { 0, 0, 0, 0, false };
+
+      result_t res;
+      res = thread::specific_key_create (&args.with, specific_destructor);
+      assert(res == result::ok);
+      res = thread::specific_key_create (&args.without);
+      assert(res == result::ok);
+      assert(args.with != args.without);
+
+      thread& self = this_thread::thread ();
+      res = self.specific (OS_INTEGER_RTOS_THREAD_SPECIFIC_KEYS, &args);
+      assert(res == EINVAL);
+
+        {
+          thread th
+            { "th", specific_func, &args };
+
+          th.join ();
+
+          // The values of this thread were not changed.
+          assert(args.own);
+          assert(self.specific (args.with) == nullptr);
+          assert(self.specific (args.without) == nullptr);
+        }
+
+      // Only the key with a destructor was processed when
+      // the thread was destroyed.
+      assert(args.destroyed == 1);
+      assert(args.kept == 0);
+
+      res = thread::specific_key_delete (args.with);
+      assert(res == result::ok);
+      res = thread::specific_key_delete (args.without);
+      assert(res == result::ok);
+
+      // A deleted key can no longer be used.
+      res = self.specific (args.with, &args);
+      assert(res == EINVAL);
+      res = thread::specific_key_delete (args.with);
+      assert(res == EINVAL);
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_SPECIFIC) */
+
+  // ==========================================================================
+
+  printf ("\n%s - Thread pools.\n", test_name);
+
+    {
+      // Allocated, the worker stacks do not fit on the main stack.
+      // Workers with a lower priority run only when this thread waits.
+      std::unique_ptr<thread_pool_inclusive<2, 4>> pool = std::make_unique<
+          thread_pool_inclusive<2, 4>> ("pool", thread::priority::below_normal);
+
+      semaphore done
+        { "done" };
+      pool_args_t args
+        { pool.get (), &this_thread::thread (), &done, 0, 0, 0 };
+
+      assert(pool->workers () == 2);
+      assert(pool->busy () == 0);
+
+      result_t res;
+      for (int i = 0; i < 3; ++i)
+        {
+          res = pool->submit (pool_func, &args);
+          assert(res == result::ok);
+        }
+
+      res = pool->try_submit (pool_func, &args);
+      assert(res == result::ok);
+
+      assert(pool->pending () == 4);
+      assert(args.count == 0);
+
+      // The queue is full.
+      res = pool->try_submit (pool_func, &args);
+      assert(res == EWOULDBLOCK);
+
+      for (int i = 0; i < 4; ++i)
+        {
+          done.wait ();
+        }
+
+      // All works ran on the workers, one at a time.
+      assert(args.count == 4);
+      assert(args.others == 4);
+      assert(args.busy == 1);
+      assert(pool->pending () == 0);
+    }
+
+    {
+      std::unique_ptr<thread_pool_inclusive<2, 4>> pool = std::make_unique<
+          thread_pool_inclusive<2, 4>> (thread::priority::below_normal);
+
+      pool_args_t args
+        { pool.get (), &this_thread::thread (), nullptr, 0, 0, 0 };
+
+      result_t res;
+      for (int i = 0; i < 3; ++i)
+        {
+          res = pool->submit (pool_func, &args);
+          assert(res == result::ok);
+        }
+
+      assert(args.count == 0);
+
+      pool.reset ();
+
+      // The destructor let the workers complete the enqueued works.
+      assert(args.count == 3);
+      assert(args.others == 3);
+    }
+
   // ==========================================================================
 
   printf ("\n%s - Message queues.\n", test_name);
@@ -1074,6 +2251,231 @@ test_cpp_api (void)
       sp2->post ();
     }
 
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE)
+
+  // ==========================================================================
+
+  printf ("\n%s - Deferred reschedule.\n", test_name);
+
+    {
+      semaphore sem
+        { "dr", semaphore::attributes_counting
+          { 3, 0 } };
+      deferred_args_t args
+        { &sem, 0 };
+
+      thread::attributes attr;
+      attr.th_priority = thread::priority::above_normal;
+
+      thread th1
+        { "th1", deferred_func, &args, attr };
+      thread th2
+        { "th2", deferred_func, &args, attr };
+      thread th3
+        { "th3", deferred_func, &args, attr };
+
+      // The higher priority threads are now waiting.
+      assert(args.count == 0);
+
+      result_t res;
+      scheduler::state_t st = scheduler::lock ();
+
+      for (int i = 0; i < 3; ++i)
+        {
+          res = sem.post ();
+          assert(res == result::ok);
+        }
+
+      // Resumed, but not switched to.
+      assert(args.count == 0);
+
+      scheduler::locked (st);
+
+      // The postponed context switch ran all of them
+      // before returning from the unlock.
+      assert(args.count == 3);
+
+      th1.join ();
+      th2.join ();
+      th3.join ();
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_DEFERRED_RESCHEDULE) */
+
+#if defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME)
+
+  // ==========================================================================
+
+  printf ("\n%s - Deferred resume from interrupts.\n", test_name);
+
+    {
+      order_args_t args
+        { "", 0 };
+
+      thread::attributes attr;
+      attr.th_priority = thread::priority::above_normal;
+
+      // The higher priority threads run and start sleeping.
+      thread tha
+        { "a", sleep_order_func, &args, attr };
+      thread thb
+        { "b", sleep_order_func, &args, attr };
+      thread thc
+        { "c", sleep_order_func, &args, attr };
+
+      // Let the clock interrupt resume all of them while the
+      // scheduler is locked; they are only queued.
+      scheduler::state_t st = scheduler::lock ();
+      clock::timestamp_t begin = sysclock.now ();
+      while (sysclock.now () - begin < 5)
+        {
+          ;
+        }
+
+      assert(args.count == 0);
+
+      scheduler::locked (st);
+
+      // The first context switch linked all of them, in resume order.
+      assert(args.count == 3);
+      assert(std::strncmp (args.names, "abc", 3) == 0);
+
+      tha.join ();
+      thb.join ();
+      thc.join ();
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_ISR_DEFERRED_RESUME) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY)
+
+  // ==========================================================================
+
+  printf ("\n%s - Multiple objects waits.\n", test_name);
+
+    {
+      semaphore sem1
+        { "ws1" };
+      semaphore sem2
+        { "ws2" };
+      message_queue mq
+        { "wq", 3, sizeof(my_msg_t) };
+
+      wait_source ws1
+        { sem1 };
+      wait_source ws2
+        { sem2 };
+      wait_source wq
+        { mq, &msg_in, sizeof(my_msg_t) };
+      wait_source* sources[] =
+        { &ws1, &ws2, &wq };
+
+      std::size_t index;
+      result_t res;
+
+      // Nothing available.
+      res = this_thread::try_wait_any (sources, 3, &index);
+      assert(res == EWOULDBLOCK);
+
+      res = this_thread::timed_wait_any (sources, 3, &index, 2);
+      assert(res == ETIMEDOUT);
+
+      // A zero timeout does not mean forever.
+      res = this_thread::timed_wait_any (sources, 3, &index, 0);
+      assert(res == ETIMEDOUT);
+
+      // With several sources available, only the first one is consumed.
+      sem1.post ();
+      sem2.post ();
+
+      res = this_thread::try_wait_any (sources, 3, &index);
+      assert(res == result::ok);
+      assert(index == 0);
+      assert(sem1.value () == 0);
+      assert(sem2.value () == 1);
+
+      res = this_thread::wait_any (sources, 3, &index);
+      assert(res == result::ok);
+      assert(index == 1);
+      assert(sem2.value () == 0);
+
+      // The message is received in the source buffer.
+      msg_in.i = 0;
+      mq.send (&msg_out, sizeof(my_msg_t));
+
+      res = this_thread::wait_any (sources, 3, &index);
+      assert(res == result::ok);
+      assert(index == 2);
+      assert(msg_in.i == msg_out.i);
+      assert(mq.empty ());
+    }
+
+    {
+      semaphore sem1
+        { "ws1" };
+      semaphore sem2
+        { "ws2" };
+
+      wait_args_t args
+        { &sem1, &sem2, ENOTRECOVERABLE, 0 };
+
+      thread::attributes attr;
+      attr.th_priority = thread::priority::high;
+
+      // The thread preempts main and waits for both semaphores.
+      thread th
+        { "ww", wait_any_func, &args, attr };
+
+      th.interrupt ();
+      th.join ();
+
+      assert(args.res == EINTR);
+    }
+
+    {
+      semaphore sem1
+        { "ws1" };
+      semaphore sem2
+        { "ws2" };
+
+      wait_args_t args1
+        { &sem1, &sem2, ENOTRECOVERABLE, 0 };
+      wait_args_t args2
+        { &sem1, &sem2, ENOTRECOVERABLE, 0 };
+
+      thread::attributes attr1;
+      attr1.th_priority = thread::priority::high;
+      thread::attributes attr2;
+      attr2.th_priority = thread::priority::above_normal;
+
+      // th1 waits for both semaphores, th2 only for the second one;
+      // th1 is first in the second semaphore list.
+      thread th1
+        { "ww1", wait_any_func, &args1, attr1 };
+      thread th2
+        { "ww2", wait_sem2_func, &args2, attr2 };
+
+        {
+          scheduler::critical_section scs;
+
+          // Both posts resume th1, which takes only the first
+          // semaphore, and must pass the second one to th2.
+          sem2.post ();
+          sem1.post ();
+        }
+
+      th1.join ();
+      th2.join ();
+
+      assert(args1.res == result::ok);
+      assert(args1.index == 0);
+      assert(args2.res == result::ok);
+      assert(sem1.value () == 0);
+      assert(sem2.value () == 0);
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_WAIT_ANY) */
+
   // ==========================================================================
 
   printf ("\n%s - Timers.\n", test_name);
@@ -1178,6 +2580,241 @@ test_cpp_api (void)
       tm2->stop ();
     }
 
+#if defined(OS_INCLUDE_RTOS_TIMER_DAEMON)
+
+  // ==========================================================================
+
+  printf ("\n%s - Timer daemon.\n", test_name);
+
+    {
+      daemon_args_t args
+        { nullptr, true, 0 };
+      timer tm
+        { "td", tmdaemon, &args };
+
+      tm.start (2);
+      sysclock.sleep_for (5);
+
+      // Called once, from a thread other than the interrupt
+      // and the caller, at the configured priority.
+      assert(args.count == 1);
+      assert(!args.in_handler);
+      assert(args.th != nullptr);
+      assert(args.th != &this_thread::thread ());
+      assert(args.th->priority () == OS_INTEGER_RTOS_TIMER_DAEMON_PRIORITY);
+      assert(tm.overruns () == 0);
+    }
+
+    {
+      daemon_args_t args
+        { nullptr, true, 0 };
+      timer::attributes attr;
+      attr.tm_type = timer::run::periodic;
+      timer tm
+        { "tp", tmdaemon, &args, attr };
+
+      tm.start (1);
+
+      // The daemon cannot run while the scheduler is locked,
+      // so the expirations past the first one are overruns.
+      scheduler::state_t st = scheduler::lock ();
+      clock::timestamp_t begin = sysclock.now ();
+      while (sysclock.now () - begin < 6)
+        {
+          ;
+        }
+      scheduler::locked (st);
+
+      tm.stop ();
+
+      assert(args.count >= 1);
+      assert(tm.overruns () >= 4);
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_TIMER_DAEMON) */
+
+#if defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK)
+
+  // ==========================================================================
+
+  printf ("\n%s - Clock lock free reads.\n", test_name);
+
+    {
+      clock::timestamp_t end = sysclock.now () + 20;
+      seqlock_args_t args1
+        { end, 0, false };
+      seqlock_args_t args2
+        { end, 0, false };
+
+      // Two readers, rotated by the ticks, interrupted by the ticks.
+      thread::attributes attr;
+      attr.th_priority = thread::priority::above_normal;
+
+      scheduler::state_t st = scheduler::lock ();
+
+      thread th1
+        { "th1", seqlock_func, &args1, attr };
+      thread th2
+        { "th2", seqlock_func, &args2, attr };
+
+      scheduler::locked (st);
+
+      th1.join ();
+      th2.join ();
+
+      assert(args1.reads > 0);
+      assert(args1.monotonic);
+      assert(args2.reads > 0);
+      assert(args2.monotonic);
+    }
+
+    {
+      // The adjustable clocks add the offset to the same steady count.
+      clock::offset_t offset = rtclock.offset ();
+      rtclock.offset (1000);
+
+      clock::timestamp_t now = rtclock.now ();
+      clock::timestamp_t steady = rtclock.steady_now ();
+      assert(now - 1000 <= steady);
+      assert(steady <= rtclock.now () - 1000);
+
+      rtclock.offset (offset);
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_SEQLOCK) */
+
+#if defined(OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL)
+
+  // ==========================================================================
+
+  printf ("\n%s - Clock timing wheel.\n", test_name);
+
+    {
+      int count1 = 0;
+      int count2 = 0;
+
+      timer tm1
+        { "tw1", tmcount, &count1 };
+      timer tm2
+        { "tw2", tmcount, &count2 };
+
+      sysclock.sleep_for (1); // Sync
+
+      // The second time stamp is more than a wheel revolution away.
+      tm1.start (3);
+      tm2.start (40);
+
+      sysclock.sleep_for (10);
+      assert(count1 == 1);
+      assert(count2 == 0);
+
+      sysclock.sleep_for (35);
+      assert(count1 == 1);
+      assert(count2 == 1);
+    }
+
+    {
+      // The hrclock time stamps are in cycles, but its wheel
+      // slots cover one tick each.
+      clock::duration_t cycles = hrclock.input_clock_frequency_hz ()
+          / clock_systick::frequency_hz;
+
+      clock::timestamp_t begin = hrclock.now ();
+      hrclock.sleep_for (3 * cycles);
+      assert(hrclock.now () - begin >= 3 * cycles);
+
+      // Stopping a timer unlinks it from its slot.
+      int count = 0;
+      timer tm
+        { "tw3", tmcount, &count };
+      tm.start (5);
+      tm.stop ();
+      sysclock.sleep_for (10);
+      assert(count == 0);
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_CLOCK_TIMING_WHEEL) */
+
+#if defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE) && !defined(__ARM_EABI__)
+
+  // ==========================================================================
+
+  printf ("\n%s - High resolution timers.\n", test_name);
+
+    {
+      clock::duration_t cycles = hrclock.input_clock_frequency_hz ()
+          / clock_systick::frequency_hz;
+
+      int count1 = 0;
+      int count2 = 0;
+      timer::attributes attr;
+      attr.clock = &hrclock;
+      timer tm1
+        { "ht1", tmcount, &count1, attr };
+      timer tm2
+        { "ht2", tmcount, &count2, attr };
+
+      sysclock.sleep_for (1); // Sync
+
+      // Due before the next tick, a compare match is requested.
+      std::size_t compares = test_hrclock_compares;
+      tm1.start (cycles / 2);
+      assert(test_hrclock_compares == compares + 1);
+      assert(test_hrclock_compare_cycles > 0);
+      assert(test_hrclock_compare_cycles <= cycles / 2);
+
+      // Due after the next tick, no compare match.
+      compares = test_hrclock_compares;
+      tm2.start (3 * cycles);
+      assert(test_hrclock_compares == compares);
+
+      // An early match does not expire the timer, but
+      // programs the compare again.
+      os_hrclock_compare_handler ();
+      assert(count1 == 0);
+      assert(test_hrclock_compares == compares + 1);
+
+      sysclock.sleep_for (5);
+      assert(count1 == 1);
+      assert(count2 == 1);
+    }
+
+#endif /* defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE) && !defined(__ARM_EABI__) */
+
+#if defined(OS_INCLUDE_RTOS_TICKLESS_IDLE) && !defined(__ARM_EABI__)
+
+  // ==========================================================================
+
+  printf ("\n%s - Tickless idle.\n", test_name);
+
+    {
+      clock::timestamp_t fired = 0;
+      timer tm
+        { "tl", tmstamp, &fired };
+
+      std::size_t sleeps = test_tickless_sleeps;
+      clock::duration_t ticks = test_tickless_ticks;
+
+      clock::timestamp_t expected;
+        {
+          interrupts::critical_section ics;
+
+          expected = sysclock.now () + 20;
+          tm.start (20);
+        }
+
+      // Only the idle thread runs meanwhile.
+      sysclock.sleep_for (30);
+
+      assert(test_tickless_sleeps > sleeps);
+      assert(test_tickless_ticks > ticks);
+
+      // The sleeps did not pass the timer time stamp.
+      assert(fired == expected);
+    }
+
+#endif /* defined(OS_INCLUDE_RTOS_TICKLESS_IDLE) */
+
   // ==========================================================================
 
   printf ("\n%s - Done.\n", test_name);
@@ -0,0 +1,280 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test-only implementations of the optional port functions,
+ * for the host ports which do not provide them.
+ */
+
+#include <cmsis-plus/rtos/os.h>
+#include <test-port.h>
+
+#include <cstring>
+
+#if !defined(__ARM_EABI__)
+
+#if defined(OS_INCLUDE_RTOS_TICKLESS_IDLE)
+
+std::size_t test_tickless_sleeps;
+os::rtos::clock::duration_t test_tickless_ticks;
+
+#endif /* defined(OS_INCLUDE_RTOS_TICKLESS_IDLE) */
+
+#if defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE)
+
+std::size_t test_hrclock_compares;
+os::rtos::clock::duration_t test_hrclock_compare_cycles;
+
+#endif /* defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT)
+
+double test_fpu_registers[test_fpu_registers_count];
+
+namespace
+{
+  struct fpu_context
+  {
+    const os::rtos::thread* th;
+    bool touched;
+    std::size_t saves;
+    std::size_t restores;
+    double registers[test_fpu_registers_count];
+  };
+
+  fpu_context fpu_contexts[8];
+
+  // Find the context of a thread, or allocate a new one.
+  fpu_context*
+  find_fpu_context (const os::rtos::thread* th, bool create = true)
+  {
+    for (auto&& ctx : fpu_contexts)
+      {
+        if (ctx.th == th)
+          {
+            return &ctx;
+          }
+      }
+
+    if (!create)
+      {
+        return nullptr;
+      }
+
+    for (auto&& ctx : fpu_contexts)
+      {
+        if (ctx.th == nullptr)
+          {
+            ctx.th = th;
+            return &ctx;
+          }
+      }
+
+    return nullptr;
+  }
+} /* namespace */
+
+void
+test_fpu_clear (void)
+{
+  os::rtos::interrupts::critical_section ics;
+
+  std::memset (fpu_contexts, 0, sizeof(fpu_contexts));
+}
+
+void
+test_fpu_touch (void)
+{
+  os::rtos::interrupts::critical_section ics;
+
+  fpu_context* ctx = find_fpu_context (&os::rtos::this_thread::thread ());
+  if (ctx != nullptr)
+    {
+      ctx->touched = true;
+    }
+}
+
+std::size_t
+test_fpu_saves (const os::rtos::thread* th)
+{
+  fpu_context* ctx = find_fpu_context (th, false);
+  return (ctx != nullptr) ? ctx->saves : 0;
+}
+
+std::size_t
+test_fpu_restores (const os::rtos::thread* th)
+{
+  fpu_context* ctx = find_fpu_context (th, false);
+  return (ctx != nullptr) ? ctx->restores : 0;
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_GUARD)
+
+namespace
+{
+  const os::rtos::thread* volatile overflowed_thread;
+} /* namespace */
+
+void
+test_stack_overflow (const os::rtos::thread* th)
+{
+  overflowed_thread = th;
+}
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_GUARD) */
+
+namespace os
+{
+  namespace rtos
+  {
+    namespace port
+    {
+      namespace scheduler
+      {
+#if defined(OS_INCLUDE_RTOS_SCHEDULER_SMP)
+
+        // The host runs only the boot core; the threads assigned
+        // to the other cores stay in their ready lists until they
+        // are allowed on the boot core.
+
+        std::size_t
+        core_id (void)
+        {
+          return 0;
+        }
+
+        void
+        lock_cores (void)
+        {
+          // A single core, nothing to exclude.
+        }
+
+        void
+        unlock_cores (void)
+        {
+          ;
+        }
+
+        void
+        reschedule_core (std::size_t core __attribute__((unused)))
+        {
+          // The other cores are not started.
+        }
+
+#endif /* defined(OS_INCLUDE_RTOS_SCHEDULER_SMP) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT)
+
+        // A thread context includes the floating point registers
+        // after its first floating point instruction.
+        bool
+        saved_fpu_context (rtos::thread* th)
+        {
+          fpu_context* ctx = find_fpu_context (th, false);
+          return (ctx != nullptr) && ctx->touched;
+        }
+
+        void
+        save_fpu_context (rtos::thread* th)
+        {
+          fpu_context* ctx = find_fpu_context (th);
+          if (ctx != nullptr)
+            {
+              ++ctx->saves;
+              std::memcpy (ctx->registers, test_fpu_registers,
+                           sizeof(test_fpu_registers));
+            }
+        }
+
+        void
+        restore_fpu_context (rtos::thread* th)
+        {
+          fpu_context* ctx = find_fpu_context (th);
+          if (ctx != nullptr)
+            {
+              ++ctx->restores;
+              std::memcpy (test_fpu_registers, ctx->registers,
+                           sizeof(test_fpu_registers));
+            }
+        }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_FPU_CONTEXT) */
+
+#if defined(OS_INCLUDE_RTOS_THREAD_STACK_GUARD)
+
+        // The host contexts do not expose their stack pointers;
+        // model one in the used part of the stack.
+        stack::element_t*
+        saved_stack_pointer (rtos::thread* th)
+        {
+          class rtos::thread::stack& st = th->stack ();
+          if (th == overflowed_thread)
+            {
+              return st.bottom () - 1;
+            }
+          return st.top () - 1;
+        }
+
+#endif /* defined(OS_INCLUDE_RTOS_THREAD_STACK_GUARD) */
+      } /* namespace scheduler */
+
+#if defined(OS_INCLUDE_RTOS_TICKLESS_IDLE)
+
+      // Simulate a timer which wakes up exactly after the
+      // requested ticks; the periodic tick is not stopped.
+      clock::duration_t
+      clock_systick::suppress_ticks_and_sleep (clock::duration_t ticks)
+      {
+        ++test_tickless_sleeps;
+        test_tickless_ticks += ticks;
+
+        return ticks;
+      }
+
+#endif /* defined(OS_INCLUDE_RTOS_TICKLESS_IDLE) */
+
+#if defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE)
+
+      // There is no compare match on the host; only record the
+      // request, the tests call os_hrclock_compare_handler().
+      void
+      clock_highres::arm_compare (clock::duration_t cycles)
+      {
+        ++test_hrclock_compares;
+        test_hrclock_compare_cycles = cycles;
+      }
+
+#endif /* defined(OS_USE_RTOS_PORT_CLOCK_HIGHRES_COMPARE) */
+    } /* namespace port */
+  } /* namespace rtos */
+} /* namespace os */
+
+#endif /* !defined(__ARM_EABI__) */
+
+// ----------------------------------------------------------------------------